@@ -0,0 +1,5 @@
+#define VERSION "1.4.1"
+#define IDENTIFIER "affe704d6f08984483d3a0d2da0091ca19dabbec"
+#define COMPILER "g++ (Debian 12.2.0-14+deb12u1) 12.2.0"
+#define FLAGS "-Wall -Wextra -O3 -pthread"
+#define DATE "Sun Oct 18 09:01:41 UTC 2026 Linux vm 6.18.44-fc-v139 x86_64"
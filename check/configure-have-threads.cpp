@@ -0,0 +1,9 @@
+#include <atomic>
+#include <thread>
+static std::atomic<int> count (0);
+static void inc () { count++; }
+int main () {
+  std::thread thread (inc);
+  thread.join ();
+  return count != 1;
+}
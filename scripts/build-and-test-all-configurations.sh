@@ -112,4 +112,9 @@ run --no-contracts -a -p
 run --no-tracing -q
 run --no-tracing -a -p
 
+# clauses referenced by arena offsets (also with incremental collection)
+
+run --compact-watches -q
+run --compact-watches -c -p
+
 echo "successfully compiled and tested ${GOOD}${ok}${NORMAL} configurations"
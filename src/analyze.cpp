@@ -260,6 +260,10 @@ Internal::analyze_literal (int lit, int & open) {
 inline void
 Internal::analyze_reason (int lit, Clause * reason, int & open) {
   assert (reason);
+  if (is_binary_reason (reason)) {
+    analyze_literal (binary_reason_literal (reason), open);
+    return;
+  }
   bump_clause (reason);
   for (const auto & other : *reason)
     if (other != lit)
@@ -302,6 +306,12 @@ inline void Internal::bump_also_reason_literals (int lit, int limit) {
   if (!v.level) return;
   Clause * reason = v.reason;
   if (!reason) return;
+  if (is_binary_reason (reason)) {
+    const int other = binary_reason_literal (reason);
+    if (bump_also_reason_literal (other) && limit > 1)
+      bump_also_reason_literals (-other, limit-1);
+    return;
+  }
   for (const auto & other : *reason) {
     if (other == lit)  continue;
     if (!bump_also_reason_literal (other)) continue;
@@ -373,65 +383,87 @@ struct analyze_trail_larger {
 /*------------------------------------------------------------------------*/
 
 // Fill the 'chain' variable with the LRAT style unit propagation proof of
-// newly learnt clause
+// newly learnt clause.  Literals marked as justified are saved on the
+// 'justified' stack and only their flags are reset at the end, so that the
+// cost is linear in the size of the walked implication graph and does not
+// depend on the number of variables (as resetting all flags would).
+// Binary reasons are justified by their other literal (see 'watch.hpp').
 
 bool justify_lit (Internal& s, int lit) {
   Flags & f = s.flags (lit);
   if (f.justified) return true;
   const Var & v = s.var (lit);
-  if (v.unit_id) {
+  if (f.fixed ()) {
     // LOG ("PROOF justify %d with %ld unit", lit, v.unit_id);
-    s.chain.push_back (v.unit_id);
+    if (v.unit_id) s.chain.push_back (v.unit_id);
   } else {
     const Clause* c = v.reason;
-    if (c) {
-        s.justify_todo.push_back({lit, c->id, c->begin (), c->end ()});
+    if (is_binary_reason (c)) {
+        s.justify_todo.push_back({lit, v.binary_id, 0, 0,
+                                  binary_reason_literal (c)});
+        return false;
+    } else if (c) {
+        s.justify_todo.push_back({lit, c->id, c->begin (), c->end (), 0});
         return false;
     } else {
       // LOG ("PROOF justify %d hyp", lit);
     }
   }
   f.justified = true;
+  s.justified.push_back (lit);
   return true;
 }
 
-void print_trace (const char *caller);
-
 void Internal::build_chain () {
-  //old_reasons moved here from global above
-  vector<Clause*> old_reasons;
-  if (!opts.lrat) return;
-  assert (conflict), assert (chain.empty ());
-  for (const auto & lit : clause) {
+  assert (conflict);
+  build_chain (clause, conflict);
+}
+
+// The same as 'build_chain' for an arbitrary clause with literals 'lits',
+// which is derived from the falsified clause 'reason' by walking the
+// implication graph from the literals in 'reason' back to the literals in
+// 'lits' (their variables are treated as assumptions) and root level
+// units.  Literals of 'reason' which are unassigned have to occur in
+// 'lits'.  This is used in inprocessing, e.g., while probing and vivifying.
+
+void Internal::build_chain (const vector<int> & lits, Clause * reason) {
+  if (!proof || !opts.lrat) return;
+  assert (reason), assert (!is_binary_reason (reason));
+  assert (chain.empty ());
+  assert (justified.empty ()), assert (justify_reasons.empty ());
+  for (const auto & lit : lits) {
     Clause * & cl = var (lit).reason;
-    old_reasons.push_back(cl);
+    justify_reasons.push_back (cl);
     cl = 0;
   }
-  for (Flags& f : ftab) f.justified = false;
-  for (const_literal_iterator i = conflict->begin (); i != conflict->end (); ++i) {
+  for (const_literal_iterator i = reason->begin (); i != reason->end (); ++i) {
       int lit = -*i;
       if (justify_lit (*this, lit)) continue;
       next: while (!justify_todo.empty ()) {
           auto& el = justify_todo.back ();
+          if (el.other) {
+              const int other = el.other;
+              el.other = 0;
+              if (!justify_lit (*this, -other)) goto next;
+          }
           while (el.begin != el.end) {
               int lit2 = *el.begin++;
               if (el.lit != lit2 && !justify_lit (*this, -lit2)) goto next;
           }
           chain.push_back (el.id);
           flags (el.lit).justified = true;
+          justified.push_back (el.lit);
           justify_todo.pop_back ();
       }
   }
-  chain.push_back (conflict->id);
-  for (unsigned i = 0; i < clause.size (); i++) {
-    var (clause[i]).reason = old_reasons[i];
-  }
-  old_reasons.clear ();
-
-  if (chain.empty()) {
-    fprintf(stderr, "!!!!Built empty chain.\n");
-    print_trace("build_chain");
+  chain.push_back (reason->id);
+  for (unsigned i = 0; i < lits.size (); i++) {
+    var (lits[i]).reason = justify_reasons[i];
   }
+  justify_reasons.clear ();
+  for (const auto & lit : justified)
+    flags (lit).justified = false;
+  justified.clear ();
 #ifdef LOGGING
   ostringstream ss;
   for (auto c : chain) ss << " " << c;
@@ -439,14 +471,35 @@ void Internal::build_chain () {
 #endif
 }
 
+// Chain of a clause 'reason' which became unit (or empty if 'lit' is zero)
+// on the root level, i.e., the unit clauses of its falsified literals
+// followed by 'reason' itself.
+
+void Internal::build_unit_chain (int lit, Clause * reason) {
+  if (!proof || !opts.lrat) return;
+  for (const auto & other : *reason) {
+    if (other == lit) continue;
+    assert (val (other) < 0);
+    assert (!var (other).level);
+    const clause_id_t id = var (other).unit_id;
+    assert (id);
+    chain.push_back (id);
+  }
+  chain.push_back (reason->id);
+}
+
 /*------------------------------------------------------------------------*/
 
-// Generate new driving clause and compute jump level.
+// Generate new driving clause and compute jump level.  Learned binary
+// clauses are not allocated and the result is then the binary reason for
+// the flipped 1st UIP literal with its identifier in 'id'.
 
-Clause * Internal::new_driving_clause (const int glue, int & jump) {
+Clause *
+Internal::new_driving_clause (const int glue, int & jump, clause_id_t & id) {
 
   const size_t size = clause.size ();
   Clause * res;
+  id = 0;
 
   if (!size) {
 
@@ -475,8 +528,13 @@ Clause * Internal::new_driving_clause (const int glue, int & jump) {
            analyze_trail_negative_rank (this), analyze_trail_larger (this));
 
     jump = var (clause[1]).level;
-    res = new_learned_redundant_clause (glue);
-    res->used = 1 + (glue <= opts.reducetier2glue);
+    if (size == 2) {
+      id = new_derived_binary_clause (true);
+      res = binary_reason (clause[1]);
+    } else {
+      res = new_learned_redundant_clause (glue);
+      res->used = 1 + (glue <= opts.reducetier2glue);
+    }
   }
 
   LOG ("jump level %d", jump);
@@ -728,7 +786,11 @@ void Internal::analyze () {
       backtrack (conflict_level - 1);
 
       LOG ("forcing %d", forced);
-      search_assign_driving (forced, conflict);
+      if (conflict == &binary_conflict_clause) {
+        const int * lits = conflict->literals;
+        const int other = lits[0] ^ lits[1] ^ forced;
+        search_assign_driving (forced, binary_reason (other), conflict->id);
+      } else search_assign_driving (forced, conflict);
 
       conflict = 0;
       STOP (analyze);
@@ -841,14 +903,15 @@ void Internal::analyze () {
   // flipped 1st UIP literal.
   //
   int jump;
-  Clause * driving_clause = new_driving_clause (glue, jump);
+  clause_id_t driving_id;
+  Clause * driving_clause = new_driving_clause (glue, jump, driving_id);
   UPDATE_AVERAGE (averages.current.jump, jump);
 
   int new_level = determine_actual_backtrack_level (jump);;
   UPDATE_AVERAGE (averages.current.level, new_level);
   backtrack (new_level);
 
-  if (uip) search_assign_driving (-uip, driving_clause);
+  if (uip) search_assign_driving (-uip, driving_clause, driving_id);
   else {
     learn_empty_clause ();
   }
@@ -864,6 +927,12 @@ void Internal::analyze () {
 
   STOP (analyze);
 
+  if (is_binary_reason (driving_clause)) {
+    const int other = binary_reason_literal (driving_clause);
+    driving_clause = binary_clause (&binary_reason_clause,
+                                    -uip, other, driving_id, true);
+  }
+
   if (driving_clause && opts.eagersubsume)
     eagerly_subsume_recently_learned_clauses (driving_clause);
 }
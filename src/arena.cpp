@@ -1,5 +1,12 @@
 #include "internal.hpp"
 
+#ifdef COMPACTWATCHES
+extern "C" {
+#include <sys/mman.h>
+#include <sys/resource.h>
+}
+#endif
+
 namespace CaDiCaL {
 
 Arena::Arena (Internal * i) {
@@ -7,6 +14,79 @@ Arena::Arena (Internal * i) {
   internal = i;
 }
 
+#ifdef COMPACTWATCHES
+
+// Both halves of the region are reserved at once, such that offsets are
+// relative to the same 'base'.  Pages are only committed when touched and
+// released again with 'madvise' when a space becomes empty in 'swap'.  We
+// reserve the 16 GB addressable by 32-bit offsets, but only a quarter of
+// the address space if it is limited (as for instance by 'mobical'), and
+// as last resort halve the size until reserving succeeds.
+
+static const size_t max_arena_reserved = (size_t) 1 << 34;
+static const size_t min_arena_reserved = (size_t) 1 << 20;
+
+void Arena::reserve () {
+  assert (!base);
+  size_t bytes = max_arena_reserved;
+  struct rlimit limit;
+  if (!getrlimit (RLIMIT_AS, &limit) &&
+      limit.rlim_cur != RLIM_INFINITY &&
+      limit.rlim_cur / 4 < bytes)
+    bytes = limit.rlim_cur / 4;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif
+  void * p;
+  while ((p = mmap (0, bytes, PROT_READ | PROT_WRITE, flags, -1, 0))
+           == MAP_FAILED)
+    if ((bytes /= 2) < min_arena_reserved)
+      fatal ("can not reserve memory for clause arena");
+  base = (char *) p;
+  reserved = bytes;
+  LOG ("reserved clause arena of %zd bytes at %p", bytes, p);
+  const size_t half = bytes / 2;
+  from.start = from.top = moved = base;
+  compacted = scanned = base;
+  from.end = base + half;
+  to.start = to.top = from.end;
+  to.end = to.start + half;
+}
+
+char * Arena::allocate (size_t bytes) {
+  if (!base) reserve ();
+  if ((size_t) (from.end - from.top) < bytes)
+    fatal ("clause arena exhausted (too many clauses)");
+  char * res = from.top;
+  from.top += bytes;
+  return res;
+}
+
+Arena::~Arena () {
+  if (base) munmap (base, reserved);
+}
+
+void Arena::prepare (size_t bytes) {
+  LOG ("preparing 'to' space of arena with %zd bytes", bytes);
+  if (!base) reserve ();
+  assert (to.top == to.start);
+  if ((size_t) (to.end - to.start) < bytes)
+    fatal ("clause arena exhausted (too many clauses)");
+}
+
+void Arena::swap () {
+  LOG ("release 'from' space of arena with %zd bytes",
+    (size_t) (from.top - from.start));
+  madvise (from.start, from.top - from.start, MADV_DONTNEED);
+  from.top = from.start;
+  std::swap (from, to);
+  moved = from.top;
+  compacted = scanned = from.start;
+}
+
+#else
+
 Arena::~Arena () {
   delete [] from.start;
   delete [] to.start;
@@ -25,6 +105,39 @@ void Arena::swap () {
     (size_t) (from.end - from.start));
   from = to;
   to.start = to.top = to.end = 0;
+  compacted = scanned = from.start;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+void Arena::region (size_t bytes, char * & start, char * & end) {
+  assert (from.start <= compacted), assert (compacted <= from.top);
+  assert (from.start <= scanned), assert (scanned <= from.top);
+  start = scanned;
+  if ((size_t) (from.top - scanned) > bytes) end = scanned + bytes;
+  else end = from.top;
+  LOG ("compacting arena region of %zd bytes", (size_t) (end - start));
+}
+
+bool Arena::compact (char * end) {
+  scanned = end;
+  if (end != from.top) return false;
+  LOG ("compacted arena from %zd to %zd bytes",
+    (size_t) (from.top - from.start), (size_t) (compacted - from.start));
+#ifdef COMPACTWATCHES
+  // Give the pages above the compacted clauses back to the system, since
+  // they are only used again by new clauses allocated on top.
+  //
+  const size_t page = sysconf (_SC_PAGESIZE);
+  char * free = (char *) align ((size_t) compacted, page);
+  if (free < from.top) madvise (free, from.top - free, MADV_DONTNEED);
+  if (moved > compacted) moved = compacted;
+#endif
+  from.top = compacted;
+  compacted = scanned = from.start;
+  return true;
 }
 
 }
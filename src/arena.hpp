@@ -51,6 +51,24 @@ namespace CaDiCaL {
 //
 // One has to be really careful with 'qi' references to arena memory.
 
+// If compiled with '-DCOMPACTWATCHES' (configure with '--compact-watches')
+// all clauses are allocated in the arena, in order to reference them by
+// 32-bit word offsets in watches (see 'watch.hpp').  Then the 'from' and
+// 'to' spaces are two fixed halves of one reserved (but only on demand
+// committed) virtual memory region and new clauses are allocated on top of
+// the 'from' space with 'allocate'.  The memory of deleted clauses is only
+// reclaimed by the next moving garbage collection, which therefore is
+// always used in this configuration (see 'arenaing' in 'collect.cpp'), or
+// by incremental compaction (see below).
+
+// Incremental garbage collection ('opts.collectinc') compacts the 'from'
+// space in place region by region without a 'to' space instead.  Clauses
+// of a region are visited in address order and either dropped or moved
+// down with 'slide' to the end of the already compacted clauses, which
+// never overlaps clauses not visited yet.  After the last region the
+// memory above the compacted clauses becomes free and compaction starts
+// again from the bottom of the 'from' space with the next region.
+
 struct Internal;
 
 class Arena {
@@ -59,6 +77,16 @@ class Arena {
 
   struct { char * start, * top, * end; } from, to;
 
+  char * compacted;     // end of compacted clauses in 'from'
+  char * scanned;       // start of next region in 'from'
+
+#ifdef COMPACTWATCHES
+  char * base;          // start of reserved region ('from' or 'to')
+  char * moved;         // end of clauses moved to 'from' by 'swap'
+  size_t reserved;      // size of reserved region
+  void reserve ();
+#endif
+
 public:
 
   Arena (Internal *);
@@ -73,9 +101,16 @@ public:
   // Does the memory pointed to by 'p' belong to this arena? More precisely
   // to the 'from' space, since that is the only one remaining after 'swap'.
   //
+  // With compact watches only clauses moved by the last garbage collection
+  // are considered, but not those allocated afterwards.
+  //
   bool contains (void * p) const {
     char * c = (char *) p;
+#ifdef COMPACTWATCHES
+    return from.start <= c && c < moved;
+#else
     return from.start <= c && c < from.top;
+#endif
   }
 
   // Allocate that amount of memory in 'to' space.  This assumes the 'to'
@@ -84,10 +119,18 @@ public:
   // not matter whether 'p' is in 'from' or allocated outside of the arena.
   //
   char * copy (const char * p, size_t bytes) {
+    char * res = claim (bytes);
+    memcpy (res, p, bytes);
+    return res;
+  }
+
+  // Only allocate that amount of memory in 'to' space, which is then
+  // copied to by the caller (used for copying clauses in parallel).
+  //
+  char * claim (size_t bytes) {
     char * res = to.top;
     to.top += bytes;
     assert (to.top <= to.end);
-    memcpy (res, p, bytes);
     return res;
   }
 
@@ -96,6 +139,54 @@ public:
   // explicitly copied to 'to' with 'copy' becomes invalid.
   //
   void swap ();
+
+  // Is 'p' allocated in 'from' space (also after 'allocate')?
+  //
+  bool allocated (void * p) const {
+    char * c = (char *) p;
+    return from.start <= c && c < from.top;
+  }
+
+  // Determine the next region '[start,end)' of at most 'bytes' for
+  // incremental compaction.  All clauses starting in this region have to
+  // be visited in address order and then the region is finished with
+  // 'compact'.  It returns 'true' if this was the last region.
+  //
+  void region (size_t bytes, char * & start, char * & end);
+  bool compact (char * end);
+
+  // Move the clause at 'p' of that size down to the compacted clauses.
+  //
+  char * slide (char * p, size_t bytes) {
+    char * res = compacted;
+    assert (res <= p);
+    if (res != p) memmove (res, p, bytes);
+    compacted += bytes;
+    return res;
+  }
+
+#ifdef COMPACTWATCHES
+
+  // Allocate memory for a new clause on top of the 'from' space.
+  //
+  char * allocate (size_t bytes);
+
+  // Translate between clause addresses and 32-bit offsets in 8 byte words
+  // relative to the start of the reserved region (thus valid for both
+  // spaces).  With one bit of the 'Watch' reference used for the binary
+  // flag this allows to address 16 GB of clause memory.
+  //
+  unsigned offset (const void * p) const {
+    const size_t bytes = (const char *) p - base;
+    assert (!(bytes & 7));
+    return bytes >> 3;
+  }
+
+  char * address (unsigned offset) const {
+    return base + ((size_t) offset << 3);
+  }
+
+#endif
 };
 
 }
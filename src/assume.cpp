@@ -85,6 +85,11 @@ void Internal::failing () {
       assert (!(f.failed & bit));
       f.failed |= bit;
 
+      if (proof && opts.lrat) {
+        assert (var (first).unit_id);
+        chain.push_back (var (first).unit_id);
+      }
+
     } else {
 
       // The 'analyzed' stack serves as working stack for a BFS through the
@@ -117,7 +122,7 @@ void Internal::failing () {
         if (v.reason) {
           assert (v.level);
           LOG (v.reason, "analyze reason");
-          for (const auto & other : *v.reason) {
+          for (const auto & other : *reason_clause (lit)) {
             Flags & f = flags (other);
             if (f.seen) continue;
             f.seen = true;
@@ -136,6 +141,12 @@ void Internal::failing () {
       }
       clear_analyzed_literals ();
 
+      // The reason of the negation of 'first' is falsified by the failed
+      // assumptions and the literals they imply, which gives the chain.
+      //
+      assert (var (first).reason);
+      if (proof) build_chain (clause, reason_clause (first));
+
       // TODO, we can not do clause minimization here, right?
     }
   }
@@ -152,7 +163,10 @@ void Internal::failing () {
   //
   external->check_learned_clause ();
   clause_id_t id = next_clause_id();
-  if (proof) {
+
+  // Clashing assumptions give a tautology, which has no LRAT chain.
+  //
+  if (proof && (!opts.lrat || !chain.empty ())) {
     proof->add_derived_clause (id, clause, false, -1);
     proof->delete_clause (id, clause);
   }
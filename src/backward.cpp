@@ -109,13 +109,22 @@ void Internal::elim_backward_clause (Eliminator & eliminator, Clause *c) {
           } else if (unit && unit != INT_MIN) {
             assert (unit);
             LOG (d, "unit %d through hyper unary resolution with", unit);
-            // PROOF_TODO (proof, "hyper unary resolution unit", 20); // TODO(Mario)
-            chain = {c->id, d->id};
+            if (proof && opts.lrat)
+              build_hyper_unary_chain (c, d, unit);
             assign_unit (unit);
             elim_propagate (eliminator, unit);
             break;
           } else if (occs (negated).size () <= (size_t) opts.elimocclim) {
-            chain = {c->id, d->id};
+            if (proof && opts.lrat) {
+              // Falsified literals of 'd' remain in the strengthened clause.
+              for (const auto & lit : *c)
+                if (val (lit) < 0 &&
+                    find (d->begin (), d->end (), lit) == d->end ())
+                  chain.push_back (var (lit).unit_id);
+              chain.push_back (c->id);
+              chain.push_back (d->id);
+            }
+            elim_touched_clause (eliminator, d);
             strengthen_clause (d, negated);
             remove_occs (occs (negated), d);
             elim_update_removed_lit (eliminator, negated);
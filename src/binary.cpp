@@ -0,0 +1,262 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Binary clauses are not allocated as 'Clause' but only exist as two
+// mirrored 'Binary' watches (see 'watch.hpp').  This saves the memory of
+// the clause and the indirection during propagation, conflict analysis and
+// all the inprocessing procedures which work on the binary implication
+// graph.  Procedures iterating over all binary clauses go through the
+// binary watch lists and only consider the watch of the clause 'lit' 'blit'
+// with 'lit < blit'.  Clause identifiers are only required if proofs are
+// traced.  Then they are stored in 'binary_ids' and 'Binary::ref' refers
+// to them.  Released references are reused.
+
+void Internal::init_binary_clauses () {
+  for (Clause * c : { &binary_conflict_clause, &binary_reason_clause }) {
+    memset ((void *) c, 0, sizeof *c);
+    c->keep = true;
+    c->glue = 2;
+    c->size = 2;
+    c->pos = 2;
+  }
+}
+
+unsigned Internal::new_binary_ref (clause_id_t id) {
+  if (!proof) return 0;
+  unsigned res;
+  if (binary_refs.empty ()) {
+    if (binary_ids.empty ()) binary_ids.push_back (0);
+    if (binary_ids.size () > max_binary_ref)
+      fatal ("maximum number of %u binary clause identifiers exhausted",
+             max_binary_ref);
+    res = binary_ids.size ();
+    binary_ids.push_back (id);
+  } else {
+    res = binary_refs.back ();
+    binary_refs.pop_back ();
+    binary_ids[res] = id;
+  }
+  return res;
+}
+
+void Internal::release_binary_ref (unsigned ref) {
+  if (!ref) return;
+  assert (ref < binary_ids.size ());
+  binary_ids[ref] = 0;
+  binary_refs.push_back (ref);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Add the binary clause in the global 'clause' as two watches.  The
+// caller is responsible for tracing it as derived clause (unless it is an
+// original clause).  Returns the (new) identifier of the clause.
+
+clause_id_t Internal::new_binary_clause (clause_id_t id, bool red,
+                                         bool hyper) {
+  assert (clause.size () == 2);
+  assert (!explicit_binaries);
+  assert (!hyper || red);
+  const int a = clause[0], b = clause[1];
+  assert (a != b), assert (a != -b);
+  if (!id) id = next_clause_id ();
+  const unsigned ref = new_binary_ref (id);
+  binary_watches (a).push_back (Binary (b, red, hyper, ref));
+  binary_watches (b).push_back (Binary (a, red, hyper, ref));
+  if (hyper) hyper_binaries++;
+  stats.current.total++;
+  stats.added.total++;
+  if (red) {
+    stats.current.redundant++;
+    stats.added.redundant++;
+  } else {
+    stats.current.irredundant++;
+    stats.added.irredundant++;
+  }
+  mark_added (a, 2, red);
+  mark_added (b, 2, red);
+  LOG (clause, "new %s binary clause[%" PRId64 "]",
+    red ? "redundant" : "irredundant", id);
+  return id;
+}
+
+// Add a derived binary clause in 'clause', e.g., learned or resolved.
+
+clause_id_t Internal::new_derived_binary_clause (bool red, bool hyper) {
+  external->check_learned_clause ();
+  const clause_id_t id = new_binary_clause (0, red, hyper);
+  if (proof)
+    proof->add_derived_binary_clause (id, clause[0], clause[1], false);
+  return id;
+}
+
+// Account for the deletion of the binary clause of the watch 'w' of 'lit'
+// without removing its watches.  This is the counterpart of 'mark_garbage'
+// for clauses and should be called once per binary clause.
+
+void Internal::delete_binary (int lit, const Binary & w) {
+  LOG ("deleting %s binary clause[%" PRId64 "] %d %d",
+    w.redundant ? "redundant" : "irredundant", binary_id (w), lit, w.blit);
+  if (proof) proof->delete_binary_clause (binary_id (w), lit, w.blit);
+  assert (stats.current.total > 0);
+  stats.current.total--;
+  if (w.redundant) {
+    assert (stats.current.redundant > 0);
+    stats.current.redundant--;
+  } else {
+    assert (stats.current.irredundant > 0);
+    stats.current.irredundant--;
+    mark_removed (lit);
+    mark_removed (w.blit);
+  }
+  if (w.hyper) assert (hyper_binaries > 0), hyper_binaries--;
+  release_binary_ref (w.ref);
+}
+
+// Remove the (first) watch with blocking literal 'blit' from the binary
+// watches of 'lit' which belongs to the same clause as 'w'.
+
+void Internal::remove_binary_watch (int lit, int blit, const Binary & w) {
+  Binaries & bs = binary_watches (lit);
+  const auto end = bs.end ();
+  auto i = bs.begin ();
+  while (i != end && (i->blit != blit || !i->mirrors (w))) i++;
+  assert (i != end);
+  for (auto j = i + 1; j != end; j++) *i++ = *j;
+  bs.resize (i - bs.begin ());
+}
+
+void Internal::delete_binary_clause (int lit, Binary w) {
+  delete_binary (lit, w);
+  remove_binary_watch (lit, w.blit, w);
+  remove_binary_watch (w.blit, lit, w);
+}
+
+// Check whether the binary clause of the watch 'w' of 'lit' is the reason
+// of one of its literals.  Without identifiers duplicated binary clauses
+// can not be distinguished and are all considered as reason.
+
+bool Internal::binary_is_reason (int lit, const Binary & w) {
+  const clause_id_t id = binary_id (w);
+  for (int i = 0; i < 2; i++) {
+    const int implied = i ? w.blit : lit, other = i ? lit : w.blit;
+    if (val (implied) <= 0) continue;
+    const Var & v = var (implied);
+    if (!v.level) continue;
+    if (v.reason != binary_reason (other)) continue;
+    if (id && v.binary_id != id) continue;
+    return true;
+  }
+  return false;
+}
+
+/*------------------------------------------------------------------------*/
+
+// A clause shrunken to a binary clause, e.g., during garbage collection,
+// subsumption or equivalent literal substitution, is replaced by an
+// implicit binary clause with the same identifier.  Thus neither its
+// deletion is traced nor the clause counters updated.  The clause itself
+// is marked garbage and collected later.
+
+void Internal::make_binary_implicit (Clause * c) {
+  assert (c->size == 2);
+  assert (!c->garbage);
+  assert (!explicit_binaries);
+  LOG (c, "making implicit");
+  const int a = c->literals[0], b = c->literals[1];
+  const unsigned ref = new_binary_ref (c->id);
+  binary_watches (a).push_back (Binary (b, c->redundant, c->hyper, ref));
+  binary_watches (b).push_back (Binary (a, c->redundant, c->hyper, ref));
+  if (c->hyper) hyper_binaries++;
+  for (int i = 0; i < 2; i++) {
+    const int lit = i ? b : a, other = i ? a : b;
+    if (val (lit) <= 0) continue;
+    Var & v = var (lit);
+    if (!v.level || v.reason != c) continue;
+    LOG ("binary reason of %d replaces clause reason", lit);
+    v.reason = binary_reason (other);
+    v.binary_id = c->id;
+  }
+  c->reason = false;
+  const size_t bytes = c->bytes ();
+  if (!c->redundant) {
+    assert (stats.irrbytes >= (int64_t) bytes);
+    stats.irrbytes -= bytes;
+  }
+  stats.garbage += bytes;
+  c->garbage = true;
+  c->used = 0;
+}
+
+// Bounded variable elimination (including blocked clause elimination and
+// covered clause elimination working on occurrence lists) and globally
+// blocked clause elimination work on clauses only.  For them binary
+// clauses are temporarily allocated with the same identifiers.  Reasons of
+// binary clauses are redirected to these clauses.
+
+void Internal::make_binaries_explicit () {
+  assert (!explicit_binaries);
+  START (binaries);
+  LOG ("making binary clauses explicit");
+  explicit_binaries = true;
+  int64_t made = 0;
+  for (auto lit : lits) {
+    Binaries & bs = binary_watches (lit);
+    for (const auto & w : bs) {
+      if (lit > w.blit) continue;
+      const clause_id_t id = binary_id (w);
+      assert (clause.empty ());
+      clause.push_back (lit);
+      clause.push_back (w.blit);
+      Clause * c = allocate_clause (id ? id : next_clause_id (),
+                                    w.redundant, 2);
+      clause.clear ();
+      c->hyper = w.hyper;
+      if (!c->redundant) stats.irrbytes += c->bytes ();
+      clauses.push_back (c);
+      for (int i = 0; i < 2; i++) {
+        const int implied = i ? w.blit : lit, other = i ? lit : w.blit;
+        if (val (implied) <= 0) continue;
+        Var & v = var (implied);
+        if (!v.level || v.reason != binary_reason (other)) continue;
+        if (id && v.binary_id != id) continue;
+        v.reason = c;
+      }
+      if (w.hyper) assert (hyper_binaries > 0), hyper_binaries--;
+      release_binary_ref (w.ref);
+      made++;
+    }
+    erase_vector (bs);
+  }
+  LOG ("made %" PRId64 " binary clauses explicit", made);
+  STOP (binaries);
+}
+
+// Replace all remaining binary clauses by implicit ones.  The clauses are
+// not watched and not referenced in occurrence lists and are thus deleted
+// immediately.
+
+void Internal::make_binaries_implicit () {
+  assert (explicit_binaries);
+  START (binaries);
+  LOG ("making binary clauses implicit");
+  explicit_binaries = false;
+  int64_t made = 0;
+  const auto end = clauses.end ();
+  auto j = clauses.begin (), i = j;
+  while (i != end) {
+    Clause * c = *j++ = *i++;
+    if (c->size > 2) continue;
+    j--;
+    if (!c->garbage) make_binary_implicit (c), made++;
+    delete_clause (c);
+  }
+  clauses.resize (j - clauses.begin ());
+  LOG ("made %" PRId64 " binary clauses implicit", made);
+  STOP (binaries);
+}
+
+}
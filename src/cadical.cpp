@@ -5,6 +5,12 @@
 #include "internal.hpp"
 #include "signal.hpp"           // Separate, only need for apps.
 
+#ifndef NTHREADS
+#include "clausering.hpp"
+#include <atomic>
+#include <thread>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 namespace CaDiCaL {
@@ -19,12 +25,93 @@ namespace CaDiCaL {
 // multiple instances of the solver use the 'Solver' interface directly
 // which is thread-safe and reentrant among different solver instances.
 
+/*------------------------------------------------------------------------*/
+#ifndef NTHREADS
+
+// With '--threads=<n>' the stand alone solver runs a portfolio of '<n>'
+// diversified solver instances in the same process.  Each instance exports
+// learned clauses into its own lock-free 'ClauseRing' and reads the rings
+// of all the other instances through a 'ClauseRingReader' (see
+// 'clausering.hpp').  The first instance which solves the formula
+// terminates the others ('Terminator').
+
+class Portfolio;
+
+class PortfolioInstance : public Terminator {
+
+  Portfolio & portfolio;
+
+public:
+
+  const int index;
+  Solver * solver;
+  ClauseRing ring;
+  ClauseRingReader reader;
+  std::thread thread;
+  const char * err;             // parse error of other instances
+  int res;
+
+  PortfolioInstance (Portfolio &, int index, Solver *);
+  ~PortfolioInstance ();
+
+  // Terminator interface.
+  //
+  bool terminate ();
+};
+
+class Portfolio {
+public:
+
+  vector<PortfolioInstance *> instances;
+  std::atomic<int> winner;      // index of first solving instance plus one
+  std::atomic<bool> failed;     // other instance failed to parse input
+  volatile bool & timesup;      // global time limit hit
+
+  // Only clauses with at most this glue are shared.
+  //
+  static const int max_glue = 8;
+
+  // Number of integers in each ring.
+  //
+  static const size_t ring_size = 1u << 20;
+
+  // Number of exported clauses buffered before publishing them.
+  //
+  static const int export_batch = 8;
+
+  // Parsing and limits applied to all instances.
+  //
+  const char * dimacs_path;
+  int force_strict_parsing;
+  int conflict_limit, decision_limit;
+  int preprocessing, localsearch;
+
+  Portfolio (volatile bool & t) : winner (0), failed (false), timesup (t)
+  { }
+  ~Portfolio ();
+
+  void diversify (Solver *, int index, const vector<const char *> &);
+  void run (PortfolioInstance *);
+  int solve ();
+  const char * error () const;
+};
+
+#endif
 /*------------------------------------------------------------------------*/
 
 class App : public Handler, public Terminator {
 
   Solver * solver;                // Global solver.
 
+#ifndef NTHREADS
+  Portfolio * portfolio;          // Other solvers if '--threads' used.
+  void init_portfolio (int threads, int optimize);
+#endif
+
+  // Options and configurations explicitly given on the command line.
+  //
+  vector<const char *> explicit_options;
+
 #ifndef __WIN32
   // Command line options.
   //
@@ -53,7 +140,7 @@ class App : public Handler, public Terminator {
   // Printing.
   //
   void print_usage (bool all = false);
-  void print_witness (FILE *);
+  void print_witness (FILE *, Solver *);
 
 #ifndef QUIET
   void signal_message (const char * msg, int sig);
@@ -118,6 +205,9 @@ void App::print_usage (bool all) {
 "\n"
 "  --instance-num <int>      unique identifier of this instance\n"
 "  --total-instances <int>   total number of running instances\n"
+#ifndef NTHREADS
+"  --threads=<n>             run portfolio of '<n>' solver threads\n"
+#endif
 ,
   all ? " (same as '--no-witness')": ""
 #ifndef QUIET
@@ -161,6 +251,12 @@ void App::print_usage (bool all) {
 "  --force | -f   parsing broken DIMACS header and writing proofs\n"
 "  --strict       strict parsing (no white space in header)\n"
 "\n"
+#ifndef NTHREADS
+"  --threads=<n>  run portfolio of '<n>' diversified solver threads\n"
+"                 which share learned clauses (default '1'), where\n"
+"                 explicitly given options apply to all threads\n"
+"\n"
+#endif
 "  -r <sol>       read solution in competition output format\n"
 "                 to check consistency of learned clauses\n"
 "                 during testing and debugging\n"
@@ -257,7 +353,7 @@ void App::print_usage (bool all) {
 
 // Pretty print competition format witness with 'v' lines.
 
-void App::print_witness (FILE * file) {
+void App::print_witness (FILE * file, Solver * solver) {
   int c = 0, i = 0, tmp;
   do {
     if (!c) fputc ('v', file), c = 1;
@@ -357,6 +453,8 @@ int App::main (int argc, char ** argv) {
   const char * time_limit_specified = 0;
   bool witness = true, less = false;
   const char * dimacs_name, * err;
+  const char * threads_specified = 0;
+  int threads = 1;
 
   for (int i = 1; i < argc; i++) {
     if (!strcmp (argv[i], "-h") ||
@@ -379,6 +477,21 @@ int App::main (int argc, char ** argv) {
         APPERR ("invalid argument in '--total-instances %s'", argv[i]);
       //solver->set_total_instances(total_instances);
       solver->set("total_instances", total_instances);
+    } else if (has_prefix (argv[i], "--threads=")) {
+      if (threads_specified)
+        APPERR ("multiple thread options '%s' and '%s'",
+          threads_specified, argv[i]);
+      threads_specified = argv[i];
+      if (!parse_int_str (argv[i] + 10, threads))
+        APPERR ("invalid thread option '%s'", argv[i]);
+      if (threads < 1)
+        APPERR ("invalid argument in '%s' (expected positive number)",
+          argv[i]);
+#ifdef NTHREADS
+      if (threads > 1)
+        APPERR ("can not use '%s' (compiled without thread support)",
+          argv[i]);
+#endif
     } else if (!strcmp (argv[i], "-")) {
       if (proof_specified) APPERR ("too many arguments");
       else if (!dimacs_specified) dimacs_specified = true;
@@ -523,8 +636,9 @@ int App::main (int argc, char ** argv) {
     } else if (has_prefix (argv[i], "--") &&
                solver->is_valid_configuration (argv[i] + 2)) {
       solver->configure (argv[i] + 2);
+      explicit_options.push_back (argv[i]);
     } else if (set (argv[i])) {
-      /* nothing do be done */
+      explicit_options.push_back (argv[i]);
     } else if (argv[i][0] == '-') APPERR ("invalid option '%s'", argv[i]);
     else if (proof_specified) APPERR ("too many arguments");
     else if (dimacs_specified) {
@@ -549,6 +663,19 @@ int App::main (int argc, char ** argv) {
     APPERR ("Proof generation specified, but no path for proof file provided",
       dimacs_path);
   }
+  if (threads > 1) {
+    if (!dimacs_path)
+      APPERR ("'%s' requires DIMACS input file (not '<stdin>')",
+        threads_specified);
+    if (proof_specified)
+      APPERR ("can not combine '%s' with proof tracing", threads_specified);
+    if (output_path)
+      APPERR ("can not combine '%s' and '-o %s'",
+        threads_specified, output_path);
+    if (extension_path)
+      APPERR ("can not combine '%s' and '-e %s'",
+        threads_specified, extension_path);
+  }
   if (dimacs_specified && dimacs_path &&
       proof_specified && proof_path &&
       !strcmp (dimacs_path, proof_path) && strcmp (dimacs_path, "-"))
@@ -649,6 +776,21 @@ int App::main (int argc, char ** argv) {
         (get ("binary") ? "binary" : "non-binary"),
         tout.green_code (), proof_path, tout.normal_code ());
   } else solver->verbose (1, "will not generate nor write DRAT proof");
+#ifndef NTHREADS
+  // Other instances copy the options before any clause is parsed and then
+  // parse the input file in their own thread later.
+  //
+  if (threads > 1) {
+    solver->section ("portfolio");
+    init_portfolio (threads, optimize);
+    portfolio->dimacs_path = dimacs_path;
+    portfolio->force_strict_parsing = force_strict_parsing;
+    portfolio->conflict_limit = conflict_limit;
+    portfolio->decision_limit = decision_limit;
+    portfolio->preprocessing = preprocessing;
+    portfolio->localsearch = localsearch;
+  }
+#endif
   solver->section ("parsing input");
   dimacs_name = dimacs_path ? dimacs_path : "<stdin>";
   string help;
@@ -669,6 +811,8 @@ int App::main (int argc, char ** argv) {
     err = solver->read_dimacs(stdin, dimacs_name, max_var, force_strict_parsing,
                             incremental, cube_literals);
   if (err) APPERR ("%s", err);
+  if (incremental && threads > 1)
+    APPERR ("can not combine '%s' with incremental input", threads_specified);
   if (read_solution_path) {
     solver->section ("parsing solution");
     solver->message ("reading solution file from '%s'", read_solution_path);
@@ -804,6 +948,12 @@ int App::main (int argc, char ** argv) {
       res = 0;
   } else {
     solver->section ("solving");
+#ifndef NTHREADS
+    if (portfolio) {
+      res = portfolio->solve ();
+      if ((err = portfolio->error ())) APPERR ("%s", err);
+    } else
+#endif
     res = solver->solve ();
   }
 
@@ -840,15 +990,33 @@ int App::main (int argc, char ** argv) {
       solver->message ("writing result to '%s'", write_result_path);
     }
 
+  Solver * winner = solver;
+#ifndef NTHREADS
+  if (portfolio && portfolio->winner)
+    winner = portfolio->instances[portfolio->winner - 1]->solver;
+#endif
+
   if (res == 10) {
     fputs ("s SATISFIABLE\n", write_result_file);
     if (witness)
-      print_witness (write_result_file);
+      print_witness (write_result_file, winner);
   } else if (res == 20) fputs ("s UNSATISFIABLE\n", write_result_file);
   else fputs ("c UNKNOWN\n", write_result_file);
   fflush (write_result_file);
   if (write_result_path)
     fclose (write_result_file);
+#ifndef NTHREADS
+  if (portfolio) {
+    solver->section ("portfolio statistics");
+    for (const auto & instance : portfolio->instances)
+      solver->message (
+        "instance %d returned %d after exporting %" PRId64
+        " and importing %" PRId64 " clauses (%" PRId64 " lost reads)",
+        instance->index + 1, instance->res, instance->ring.clauses,
+        instance->reader.clauses, instance->reader.lost);
+    solver->message ("winning instance %d", (int) portfolio->winner);
+  }
+#endif
   solver->statistics ();
   solver->resources ();
   solver->section ("shutting down");
@@ -894,14 +1062,159 @@ void App::init () {
 
 /*------------------------------------------------------------------------*/
 
-App::App () : solver (0) { }      // Only partially initialize the app.
+App::App () : solver (0)           // Only partially initialize the app.
+#ifndef NTHREADS
+, portfolio (0)
+#endif
+{ }
 
 App::~App () {
   if (!solver) return;            // Only partially initialized.
   Signal::reset ();
+#ifndef NTHREADS
+  if (portfolio) delete portfolio;
+#endif
   delete solver;
 }
 
+/*------------------------------------------------------------------------*/
+#ifndef NTHREADS
+
+PortfolioInstance::PortfolioInstance (Portfolio & p, int i, Solver * s) :
+  portfolio (p), index (i), solver (s),
+  ring (Portfolio::ring_size, Portfolio::max_glue), err (0), res (0)
+{
+}
+
+PortfolioInstance::~PortfolioInstance () {
+  if (index) delete solver;     // The first solver is owned by 'App'.
+}
+
+bool PortfolioInstance::terminate () {
+  return portfolio.winner.load (std::memory_order_relaxed) ||
+         portfolio.failed.load (std::memory_order_relaxed) ||
+         portfolio.timesup;
+}
+
+/*------------------------------------------------------------------------*/
+
+Portfolio::~Portfolio () {
+  for (const auto & instance : instances)
+    delete instance;
+}
+
+// All instances except the first one use a different seed and are further
+// diversified by alternating between the default, a negative initial
+// phase and the 'sat' and 'unsat' configurations.  Options given
+// explicitly on the command line are applied again afterwards and thus
+// take precedence, except that the seed is only shifted.
+
+void Portfolio::diversify (Solver * solver, int index,
+                           const vector<const char *> & options) {
+  assert (index > 0);
+  switch (index % 4) {
+    case 1: solver->set ("phase", 0); break;
+    case 2: solver->configure ("sat"); break;
+    case 3: solver->configure ("unsat"); break;
+    default: break;
+  }
+  for (const auto & arg : options)
+    if (has_prefix (arg, "--") && solver->is_valid_configuration (arg + 2))
+      solver->configure (arg + 2);
+    else solver->set_long_option (arg);
+  solver->set ("seed", solver->get ("seed") + index);
+}
+
+// Thread function of each instance.  All but the first instance still
+// have to parse the input and set limits as in 'App::main'.
+
+void Portfolio::run (PortfolioInstance * instance) {
+  Solver * solver = instance->solver;
+  if (instance->index) {
+    int vars;
+    const char * err =
+      solver->read_dimacs (dimacs_path, vars, force_strict_parsing);
+    if (err) {
+      instance->err = err;
+      failed = true;
+      return;
+    }
+    if (preprocessing > 0) solver->limit ("preprocessing", preprocessing);
+    if (localsearch > 0) solver->limit ("localsearch", localsearch);
+    if (conflict_limit >= 0) solver->limit ("conflicts", conflict_limit);
+    if (decision_limit >= 0) solver->limit ("decisions", decision_limit);
+  }
+  int res = solver->solve ();
+  instance->res = res;
+  int expected = 0;
+  if (res) winner.compare_exchange_strong (expected, instance->index + 1);
+}
+
+int Portfolio::solve () {
+  for (const auto & instance : instances)
+    if (instance->index)
+      instance->thread = std::thread (&Portfolio::run, this, instance);
+  run (instances[0]);
+  for (const auto & instance : instances)
+    if (instance->index)
+      instance->thread.join ();
+  for (const auto & instance : instances)
+    instance->solver->disconnect_clause_exporter ();
+  if (!winner) return 0;
+  return instances[winner - 1]->res;
+}
+
+// The first parse error of the other instances (which is reported by
+// 'App::main' after all threads joined).
+
+const char * Portfolio::error () const {
+  for (const auto & instance : instances)
+    if (instance->err) return instance->err;
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Instance numbers are interleaved with '--instance-num' and
+// '--total-instances', such that clause identifiers remain unique even if
+// several processes run a portfolio each.
+
+void App::init_portfolio (int threads, int optimize) {
+  assert (!portfolio);
+  assert (threads > 1);
+  const int instance_num = get ("instance_num");
+  const int total_instances = get ("total_instances");
+  solver->message ("running portfolio of %d solver threads", threads);
+  portfolio = new Portfolio (timesup);
+  for (int i = 0; i < threads; i++) {
+    Solver * other;
+    if (i) {
+      other = new Solver ();
+      solver->copy (*other);
+      portfolio->diversify (other, i, explicit_options);
+      if (optimize > 0) other->optimize (optimize);
+#ifndef QUIET
+      other->set ("quiet", 1);
+#endif
+    } else other = solver;
+    other->set ("instance_num", (instance_num - 1) * threads + i + 1);
+    other->set ("total_instances", total_instances * threads);
+    PortfolioInstance * instance =
+      new PortfolioInstance (*portfolio, i, other);
+    portfolio->instances.push_back (instance);
+    other->connect_terminator (instance);
+    other->connect_clause_exporter (&instance->ring,
+                                    Portfolio::export_batch);
+  }
+  for (const auto & instance : portfolio->instances) {
+    for (const auto & other : portfolio->instances)
+      if (other != instance) instance->reader.connect (&other->ring);
+    instance->solver->connect_learn_source (&instance->reader);
+  }
+}
+
+#endif
+
 /*------------------------------------------------------------------------*/
 
 #ifndef QUIET
@@ -193,6 +193,7 @@ struct External;
 // Forward declaration of call-back classes. See bottom of this file.
 
 class Learner;
+class ClauseExporter;
 class Terminator;
 class ClauseIterator;
 class WitnessIterator;
@@ -285,6 +286,18 @@ public:
   void connect_learner (Learner * learner);
   void disconnect_learner ();
 
+  // Add call-back which exports learned clauses as a whole (instead of
+  // literal by literal as with 'Learner').  If 'batch' is larger than one
+  // then clauses are buffered and handed over 'batch' clauses at a time
+  // through 'ClauseExporter::export_clauses'.  Remaining buffered clauses
+  // are flushed at the end of 'solve' and when disconnecting.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void connect_clause_exporter (ClauseExporter * exporter, int batch = 0);
+  void disconnect_clause_exporter ();
+
   void connect_learn_source (LearnSource * learnSource);
   void disconnect_learn_source ();
 
@@ -874,11 +887,58 @@ public:
   virtual void learn (int lit) = 0;
 };
 
+// Connected clause exporters get learned clauses in one call, given by
+// their clause id, glue and literals.  The 'exporting' filter is asked
+// first for each clause and it has to return 'true' for the clause to be
+// exported.  In batched mode (see 'connect_clause_exporter') clauses are
+// collected as packed records and handed over together to
+// 'export_clauses'.  Each record starts with the number 'n' of following
+// integers, followed by the clause in the same format as returned by
+// 'LearnSource::getNextClause', i.e.,
+//
+//   n=3    id_lo id_hi lit                       (unit clause)
+//   n>=5   glue id_lo id_hi lit_1 ... lit_(n-3)  (larger clause)
+//
+// where 'id_lo' and 'id_hi' are the two halves of the 64-bit clause id
+// copied in memory order.  The default 'export_clauses' implementation
+// just decodes these records and calls 'export_clause' for each of them.
+
+class ClauseExporter {
+public:
+  virtual ~ClauseExporter () { }
+  virtual bool exporting (int size, int glue) {
+    (void) size, (void) glue;
+    return true;
+  }
+  virtual void export_clause (int64_t id, int glue,
+                              const int * lits, int size) = 0;
+  virtual void export_clauses (const int * records, size_t size,
+                               int clauses);
+};
+
+// Connected learn sources provide clauses to be imported.  Each clause
+// returned by 'getNextClause' is in the format described for packed
+// records of 'ClauseExporter' above (without the leading size).  The
+// solver only keeps a reference to the returned vector until the clause
+// is imported.
+//
+// Alternatively a learn source can hand over many clauses at once through
+// 'getNextClauses', which returns a pointer to 'size' integers holding
+// packed clause records (with leading size) or zero if there are none.
+// The solver walks these records in place without copying them, and thus
+// the buffer has to stay valid until the next call to the learn source.
+// In this case 'hasNextClause' should return 'true' as long as either
+// single clauses or buffers of clauses are pending.
+
 class LearnSource {
 public:
   virtual ~LearnSource () { }
   virtual bool hasNextClause () = 0;
   virtual const std::vector<int>& getNextClause () = 0;
+  virtual const int * getNextClauses (size_t & size) {
+    size = 0;
+    return 0;
+  }
 };
 
 /*------------------------------------------------------------------------*/
@@ -51,7 +51,7 @@ void Internal::mark_removed (Clause * c, int except) {
 // 'ternary' preprocessing reconsider clauses on an added literal as well as
 // trying to block clauses on it.
 
-inline void Internal::mark_added (int lit, int size, bool redundant) {
+void Internal::mark_added (int lit, int size, bool redundant) {
   mark_subsume (lit);
   if (size == 3)
     mark_ternary (lit);
@@ -68,7 +68,10 @@ void Internal::mark_added (Clause * c) {
 
 /*------------------------------------------------------------------------*/
 
-Clause * Internal::new_clause (clause_id_t id, bool red, int glue) {
+// Allocate and initialize a clause with the literals in 'clause' without
+// updating statistics nor adding it to 'clauses'.
+
+Clause * Internal::allocate_clause (clause_id_t id, bool red, int glue) {
 
   assert (clause.size () <= (size_t) INT_MAX);
   const int size = (int) clause.size ();
@@ -84,11 +87,17 @@ Clause * Internal::new_clause (clause_id_t id, bool red, int glue) {
   else keep = false;
 
   size_t bytes = Clause::bytes (size);
-  Clause * c = (Clause *) new char[bytes];
+#ifdef COMPACTWATCHES
+  Clause * c = (Clause *) arena.allocate (bytes);
+  const bool slabbed = false;
+#else
+  const bool slabbed = opts.slab;
+  Clause * c;
+  if (slabbed) c = (Clause *) slab.allocate (bytes);
+  else c = (Clause *) new char[bytes];
+#endif
 
-  stats.added.total++;
-  //To allow multiple instances, we step each use
-  c->id = id ? id : next_clause_id();
+  c->id = id;
 
   c->conditioned = false;
   c->covered = false;
@@ -102,6 +111,7 @@ Clause * Internal::new_clause (clause_id_t id, bool red, int glue) {
   c->moved = false;
   c->reason = false;
   c->redundant = red;
+  c->slab = slabbed;
   c->transred = false;
   c->subsume = false;
   c->vivified = false;
@@ -119,6 +129,20 @@ Clause * Internal::new_clause (clause_id_t id, bool red, int glue) {
   //
   assert (c->bytes () == bytes);
 
+  return c;
+}
+
+// Binary clauses are only allocated in explicit mode (see 'binary.cpp').
+
+Clause * Internal::new_clause (clause_id_t id, bool red, int glue) {
+
+  assert (clause.size () > 2 || explicit_binaries);
+
+  stats.added.total++;
+  //To allow multiple instances, we step each use
+  Clause * c = allocate_clause (id ? id : next_clause_id(), red, glue);
+
+  const size_t bytes = c->bytes ();
   stats.current.total++;
   stats.added.total++;
 
@@ -191,6 +215,10 @@ size_t Internal::shrink_clause (Clause * c, int new_size) {
   c->size = new_size;
   size_t new_bytes = c->bytes ();
   size_t res = old_bytes - new_bytes;
+#ifndef COMPACTWATCHES
+  if (c->slab && !arena.contains ((char *) c))
+    slab.shrink ((char *) c, old_bytes, new_bytes);
+#endif
 
   if (c->redundant) promote_clause (c, min (c->size-1, c->glue));
   else if (old_bytes > new_bytes) {
@@ -205,13 +233,18 @@ size_t Internal::shrink_clause (Clause * c, int new_size) {
 
 // This is the 'raw' deallocation of a clause.  If the clause is in the
 // arena nothing happens.  If the clause is not in the arena its memory is
-// reclaimed immediately.
+// reclaimed immediately, i.e., put on a free list of the slab or deleted.
 
 void Internal::deallocate_clause (Clause * c) {
+#ifdef COMPACTWATCHES
+  (void) c;             // reclaimed by next moving garbage collection
+#else
   char * p = (char*) c;
   if (arena.contains (p)) return;
   LOG (c, "deallocate pointer %p", (void*) c);
-  delete [] p;
+  if (c->slab) slab.deallocate (p, c->bytes ());
+  else delete [] p;
+#endif
 }
 
 void Internal::delete_clause (Clause * c) {
@@ -221,17 +254,6 @@ void Internal::delete_clause (Clause * c) {
   if (c->garbage) {
     assert (stats.garbage >= (int64_t) bytes);
     stats.garbage -= bytes;
-
-    // See the discussion in 'propagate' on avoiding to eagerly trace binary
-    // clauses as deleted (produce 'd ...' lines) as soon they are marked
-    // garbage.  We avoid this and only trace them as deleted when they are
-    // actually deleted here.  This allows the solver to propagate binary
-    // garbage clauses without producing incorrect 'd' lines.  The effect
-    // from the proof perspective is that the deletion of these binary
-    // clauses occurs later in the proof file.
-    //
-    if (proof && c->size == 2)
-      proof->delete_clause (c);
   }
   deallocate_clause (c);
 }
@@ -256,11 +278,7 @@ void Internal::mark_garbage (Clause * c) {
 
   assert (!c->garbage);
 
-  // Delay tracing deletion of binary clauses.  See the discussion above in
-  // 'delete_clause' and also in 'propagate'.
-  //
-  if (proof && c->size != 2)
-    proof->delete_clause (c);
+  if (proof) proof->delete_clause (c);
 
   assert (stats.current.total > 0);
   stats.current.total--;
@@ -336,6 +354,10 @@ void Internal::add_new_original_clause (clause_id_t id) {
         tmp = val (lit);
         if (tmp < 0) {
           LOG ("removing falsified literal %d", lit);
+          if (proof && opts.lrat) {
+            assert (var (lit).unit_id);
+            chain.push_back (var (lit).unit_id);
+          }
         } else if (tmp > 0) {
           LOG ("satisfied since literal %d true", lit);
           skip = true;
@@ -349,6 +371,7 @@ void Internal::add_new_original_clause (clause_id_t id) {
       unmark (lit);
   }
   if (skip) {
+    chain.clear ();
     if (proof) proof->delete_clause (id, original);
   } else {
     size_t size = clause.size ();
@@ -379,12 +402,14 @@ void Internal::add_new_original_clause (clause_id_t id) {
         external->check_learned_clause ();
         if (proof) {
           out_to_proof = true;
-          PROOF_TODO (proof, "minified original clause", 30); // TODO(Mario)
+          if (opts.lrat) chain.push_back (id);
           proof->add_derived_clause (cid, clause, false, -1);
           proof->delete_clause (id, original);
         }
       }
       assign_original_unit (cid, clause[0]);
+    } else if (size == 2) {
+      new_binary_clause (cid, false);
     } else {
       Clause * c = new_clause (cid, false);
       watch_clause (c);
@@ -392,7 +417,7 @@ void Internal::add_new_original_clause (clause_id_t id) {
     if (original.size () > size) {
       external->check_learned_clause ();
       if (proof && !out_to_proof) {
-        PROOF_TODO (proof, "minified original clause", 30); // TODO(Mario)
+        if (opts.lrat) chain.push_back (id);
         proof->add_derived_clause (cid, clause, false, -1);
         proof->delete_clause (id, original);
       }
@@ -403,11 +428,12 @@ void Internal::add_new_original_clause (clause_id_t id) {
 }
 
 // Add learned new clause during conflict analysis and watch it. Requires
-// that the clause is at least of size 2, and the first two literals
-// are assigned at the highest decision level.
+// that the clause is larger than a binary clause (see 'new_driving_clause'
+// for learned binary clauses), and the first two literals are assigned at
+// the highest decision level.
 //
 Clause * Internal::new_learned_redundant_clause (int glue) {
-  assert (clause.size () > 1);
+  assert (clause.size () > 2);
 #ifndef NDEBUG
   for (size_t i = 2; i < clause.size (); i++)
     assert (var (clause[0]).level >= var (clause[i]).level),
@@ -421,22 +447,25 @@ Clause * Internal::new_learned_redundant_clause (int glue) {
   return res;
 }
 
-// Add hyper binary resolved clause during 'probing'.
+// Add hyper binary resolved clause during 'probing' and return its
+// identifier.  Redundant hyper binary resolvents are marked as 'hyper'.
 //
-Clause * Internal::new_hyper_binary_resolved_clause (bool red, int glue) {
-  external->check_learned_clause ();
-  Clause * res = new_clause (0, red, glue);
-  if (proof) proof->add_derived_clause (res, false);
+clause_id_t Internal::new_hyper_binary_resolved_clause (bool red) {
+  assert (clause.size () == 2);
   assert (watching ());
-  watch_clause (res);
-  return res;
+  return new_derived_binary_clause (red, red);
 }
 
-// Add hyper ternary resolved clause during 'ternary'.
+// Add hyper ternary resolved clause during 'ternary'.  Binary resolvents
+// are added as binary clauses and then zero is returned.
 //
 Clause * Internal::new_hyper_ternary_resolved_clause (bool red) {
-  external->check_learned_clause ();
   size_t size = clause.size ();
+  if (size == 2) {
+    new_derived_binary_clause (red, red);
+    return 0;
+  }
+  external->check_learned_clause ();
   Clause * res = new_clause (0, red, size);
   if (proof) proof->add_derived_clause (res, false);
   assert (!watching ());
@@ -444,9 +473,15 @@ Clause * Internal::new_hyper_ternary_resolved_clause (bool red) {
 }
 
 // Add a new clause with same glue and redundancy as 'orig' but literals are
-// assumed to be in 'clause' in 'decompose' and 'vivify'.
+// assumed to be in 'clause' in 'decompose' and 'vivify'.  Binary clauses
+// are not allocated and then zero is returned.
 //
 Clause * Internal::new_clause_as (const Clause * orig) {
+  if (clause.size () == 2) {
+    assert (watching ());
+    new_derived_binary_clause (orig->redundant);
+    return 0;
+  }
   external->check_learned_clause ();
   const int new_glue = orig->glue;
   Clause * res = new_clause (0, orig->redundant, new_glue);
@@ -37,6 +37,7 @@ struct Clause {
   bool moved:1;       // moved during garbage collector ('copy' valid)
   bool reason:1;      // reason / antecedent clause can not be collected
   bool redundant:1;   // aka 'learned' so not 'irredundant' (original)
+  bool slab:1;        // allocated in slab (see 'slab.hpp')
   bool transred:1;    // already checked for transitive reduction
   bool subsume:1;     // not checked in last subsumption round
   unsigned used:2;    // resolved in conflict analysis since last 'reduce'
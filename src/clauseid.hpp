@@ -0,0 +1,75 @@
+#ifndef _clauseid_hpp_INCLUDED
+#define _clauseid_hpp_INCLUDED
+
+#include "util.hpp"     // Alphabetically after 'clauseid'.
+
+namespace CaDiCaL {
+
+// Clause identifiers of derived clauses have to be globally unique among
+// all solver instances working on the same problem.  The first
+// 'num_original_clauses' identifiers are used for original clauses.  The
+// remaining identifiers are split into blocks of 'block' consecutive
+// identifiers and these blocks are interleaved among all the instances,
+// i.e., instance 'instance' (counting from '1') owns the blocks
+//
+//   instance - 1, instance - 1 + total, instance - 1 + 2*total, ...
+//
+// With the default block size of one this yields the original scheme
+//
+//   num_original_clauses + instance + total * count
+//
+// for the 'count'-th learned clause of an instance.  Larger blocks keep
+// the identifiers of one instance consecutive which for instance makes
+// them cheaper to encode relative to each other in binary proofs.
+//
+// The parameters are copied from the options whenever they are set, such
+// that 'next' does not have to look up options by name and only needs a
+// comparison and an increment in the common case.
+
+class ClauseIdAllocator {
+
+  clause_id_t original;         // number of original clauses
+  clause_id_t instance;         // instance number (starting at '1')
+  clause_id_t total;            // total number of instances
+  clause_id_t block;            // number of consecutive identifiers
+  clause_id_t reserved;         // number of blocks reserved so far
+  clause_id_t current, end;     // remaining identifiers in current block
+
+  void reserve () {
+    current = original + block * (total * reserved++ + instance - 1) + 1;
+    end = current + block;
+  }
+
+public:
+
+  ClauseIdAllocator () :
+    original (0), instance (1), total (1), block (1),
+    reserved (0), current (0), end (0)
+  { }
+
+  // Snapshot parameters (again).  If they changed the rest of the current
+  // block is dropped and later blocks are computed with the new values.
+
+  void init (int num_original_clauses, int instance_num,
+             int total_instances, int block_size) {
+    assert (num_original_clauses >= 0);
+    assert (instance_num > 0), assert (total_instances > 0);
+    assert (block_size > 0);
+    if (original == num_original_clauses && instance == instance_num &&
+        total == total_instances && block == block_size) return;
+    original = num_original_clauses;
+    instance = instance_num;
+    total = total_instances;
+    block = block_size;
+    current = end = 0;
+  }
+
+  clause_id_t next () {
+    if (current == end) reserve ();
+    return current++;
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,167 @@
+#include "clausering.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+static uint64_t round_up_to_power_of_two (size_t size) {
+  uint64_t res = 1;
+  while (res < size) res <<= 1;
+  return res;
+}
+
+ClauseRing::ClauseRing (size_t c, int g, int s) :
+  capacity (round_up_to_power_of_two (c)),
+  written (0), published (0),
+  max_glue (g), max_size (s), clauses (0)
+{
+  data = new std::atomic<int>[capacity];
+}
+
+ClauseRing::~ClauseRing () { delete [] data; }
+
+void ClauseRing::publish (const int * r) {
+  const uint64_t n = (uint64_t) r[0] + 1;
+  if (n > capacity) return;
+  const uint64_t start = published.load (std::memory_order_relaxed);
+  const uint64_t end = start + n;
+  written.store (end, std::memory_order_relaxed);
+  std::atomic_thread_fence (std::memory_order_release);
+  for (uint64_t i = 0; i < n; i++)
+    data[(start + i) & (capacity - 1)].store (r[i],
+                                              std::memory_order_relaxed);
+  published.store (end, std::memory_order_release);
+  clauses++;
+}
+
+/*------------------------------------------------------------------------*/
+
+// The learner gets 'size + 2' (or '3' for units) first and then the
+// record without its leading length terminated by zero.  Since the two
+// halves of the clause id might be zero too we have to count.
+
+bool ClauseRing::learning (int size) {
+  if (!size) return false;              // Do not share the empty clause.
+  const int lits = size == 3 ? 1 : size - 2;
+  if (max_size && lits > max_size) return false;
+  record.clear ();
+  record.push_back (size == 3 ? 3 : size + 1);
+  return true;
+}
+
+void ClauseRing::learn (int lit) {
+  assert (!record.empty ());
+  if (record.size () <= (size_t) record[0]) {
+    record.push_back (lit);
+    return;
+  }
+  assert (!lit), (void) lit;
+  if (record[0] > 3 && max_glue && record[1] > max_glue) return;
+  publish (record.data ());
+}
+
+/*------------------------------------------------------------------------*/
+
+bool ClauseRing::exporting (int size, int glue) {
+  if (max_size && size > max_size) return false;
+  if (max_glue && glue > max_glue) return false;
+  return true;
+}
+
+void ClauseRing::export_clause (int64_t id, int glue,
+                                const int * lits, int size) {
+  record.clear ();
+  if (size == 1) record.push_back (3);
+  else record.push_back (size + 3), record.push_back (glue);
+  int halves[2];
+  memcpy (halves, &id, sizeof id);
+  record.push_back (halves[0]);
+  record.push_back (halves[1]);
+  record.insert (record.end (), lits, lits + size);
+  publish (record.data ());
+}
+
+void ClauseRing::export_clauses (const int * records, size_t size,
+                                 int exported) {
+  const int * p = records, * end = records + size;
+  while (p != end) {
+    assert (p < end);
+    publish (p);
+    p += *p + 1;
+    exported--;
+  }
+  assert (!exported), (void) exported;
+}
+
+/*------------------------------------------------------------------------*/
+
+bool ClauseRing::read (uint64_t & tail, std::vector<int> & records) const {
+  const uint64_t end = published.load (std::memory_order_acquire);
+  if (end == tail) return true;
+  bool lost = end - tail > capacity;
+  if (!lost) {
+    const size_t before = records.size ();
+    for (uint64_t p = tail; p != end; p++)
+      records.push_back (
+        data[p & (capacity - 1)].load (std::memory_order_relaxed));
+    std::atomic_thread_fence (std::memory_order_acquire);
+    if (written.load (std::memory_order_relaxed) - tail > capacity) {
+      records.resize (before);
+      lost = true;
+    }
+  }
+  tail = end;
+  return !lost;
+}
+
+/*------------------------------------------------------------------------*/
+
+ClauseRingReader::ClauseRingReader () : consumed (0), clauses (0), lost (0)
+{
+}
+
+void ClauseRingReader::connect (const ClauseRing * ring) {
+  rings.push_back (ring);
+  tails.push_back (ring->head ());
+}
+
+// Copy new records from all rings unless there are unconsumed ones left.
+
+bool ClauseRingReader::receive () {
+  if (consumed < received.size ()) return true;
+  received.clear ();
+  consumed = 0;
+  for (size_t i = 0; i < rings.size (); i++) {
+    const ClauseRing * ring = rings[i];
+    if (ring->empty (tails[i])) continue;
+    if (!ring->read (tails[i], received)) lost++;
+  }
+  return !received.empty ();
+}
+
+bool ClauseRingReader::hasNextClause () { return receive (); }
+
+const std::vector<int> & ClauseRingReader::getNextClause () {
+  bool ok = receive ();
+  assert (ok), (void) ok;
+  const int * record = received.data () + consumed;
+  clause.assign (record + 1, record + record[0] + 1);
+  consumed += record[0] + 1;
+  clauses++;
+  return clause;
+}
+
+const int * ClauseRingReader::getNextClauses (size_t & size) {
+  if (!receive ()) { size = 0; return 0; }
+  const int * res = received.data () + consumed;
+  size = received.size () - consumed;
+  for (const int * p = res, * end = res + size; p != end; p += *p + 1)
+    clauses++;
+  consumed = received.size ();
+  return res;
+}
+
+}
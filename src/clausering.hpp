@@ -0,0 +1,132 @@
+#ifndef _clausering_hpp_INCLUDED
+#define _clausering_hpp_INCLUDED
+
+#include "cadical.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Lock-free clause exchange between solver instances running in different
+// threads.  Each solver writes its learned clauses into its own ring
+// buffer, connected either as 'ClauseExporter' (preferably, possibly in
+// batched mode) or as 'Learner' (but not both).  Clauses are stored as
+// packed records in the format described for 'ClauseExporter' in
+// 'cadical.hpp'.  Publishing a clause is wait-free.  The ring has a fixed
+// capacity and overwrites the oldest records if it is full.
+//
+// Each solver reads the rings of the other solvers through a
+// 'ClauseRingReader' connected as 'LearnSource', which keeps its own read
+// position for each ring.  Readers falling behind by more than the
+// capacity of a ring lose the overwritten records (counted in 'lost'),
+// which is fine since shared clauses are redundant.  Readers never block
+// the writer nor other readers.
+//
+// Only the thread of the solver owning the ring is allowed to write to it,
+// while any number of readers in other threads can read it concurrently.
+
+class ClauseRing : public Learner, public ClauseExporter {
+
+  std::atomic<int> * data;
+  const uint64_t capacity;              // power of two
+
+  // Records in the range '[published - capacity, published)' are
+  // complete.  The writer increases 'written' before overwriting old
+  // records and then 'published' after writing the new record.  Readers
+  // first copy records and afterwards check with 'written' whether they
+  // were overwritten in the mean time (similar to a sequence lock).
+
+  std::atomic<uint64_t> written;
+  std::atomic<uint64_t> published;
+
+  std::vector<int> record;              // record learned through 'Learner'
+
+  ClauseRing (const ClauseRing &);      // Not copyable.
+  ClauseRing & operator= (const ClauseRing &);
+
+public:
+
+  // Clauses with larger glue or size are not shared ('0' = unlimited).
+  //
+  int max_glue, max_size;
+
+  int64_t clauses;                      // number of published clauses
+
+  // The capacity is given in number of integers and rounded up to the next
+  // power of two.  A record of a clause of size 'k' takes 'k + 4'
+  // integers.
+  //
+  ClauseRing (size_t capacity = 1u << 20, int max_glue = 0,
+              int max_size = 0);
+  ~ClauseRing ();
+
+  // Writer side.  The record starts with its length 'n' followed by 'n'
+  // integers.  Records larger than the capacity are silently ignored.
+  //
+  void publish (const int * record);
+
+  // Learner interface.
+  //
+  bool learning (int size);
+  void learn (int lit);
+
+  // ClauseExporter interface.
+  //
+  bool exporting (int size, int glue);
+  void export_clause (int64_t id, int glue, const int * lits, int size);
+  void export_clauses (const int * records, size_t size, int clauses);
+
+  // Reader side.  The position after the last published record and
+  // whether there are new records after 'tail'.
+  //
+  uint64_t head () const {
+    return published.load (std::memory_order_acquire);
+  }
+
+  bool empty (uint64_t tail) const { return head () == tail; }
+
+  // Append the records published after 'tail' to 'records' and move 'tail'
+  // to the end.  Returns 'false' if records were overwritten before they
+  // could be read.  Then no record is appended.
+  //
+  bool read (uint64_t & tail, std::vector<int> & records) const;
+};
+
+/*------------------------------------------------------------------------*/
+
+class ClauseRingReader : public LearnSource {
+
+  std::vector<const ClauseRing *> rings;
+  std::vector<uint64_t> tails;          // read position in each ring
+
+  std::vector<int> received;            // records read from rings
+  size_t consumed;                      // already returned records
+  std::vector<int> clause;              // for 'getNextClause'
+
+  bool receive ();
+
+public:
+
+  int64_t clauses;                      // number of returned clauses
+  int64_t lost;                         // number of missed reads
+
+  ClauseRingReader ();
+
+  // Start reading clauses published from now on to this ring.
+  //
+  void connect (const ClauseRing *);
+
+  // LearnSource interface.
+  //
+  bool hasNextClause ();
+  const std::vector<int> & getNextClause ();
+  const int * getNextClauses (size_t & size);
+};
+
+}
+
+#endif
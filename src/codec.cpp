@@ -0,0 +1,220 @@
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+// In-process compression and decompression of files through 'zlib' and
+// 'liblzma' (if configured with '--zlib' respectively '--lzma').  The
+// compressed streams are wrapped into ordinary 'FILE' objects with
+// 'fopencookie', so 'File' can use the same (unlocked) character IO as
+// for uncompressed files and pipes.  This avoids starting external
+// compression utilities and copying all data through a pipe.
+
+#if defined(ZLIB) || defined(LZMA)
+extern "C" {
+#include <stdio.h>
+#include <string.h>
+}
+#endif
+
+#ifdef ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef LZMA
+#include <lzma.h>
+#endif
+
+namespace CaDiCaL {
+
+#if defined(ZLIB) || defined(LZMA)
+
+// Size of the buffer of the returned 'FILE' and of the compressed data.
+
+static const size_t codec_buffer_size = 1 << 17;
+
+static FILE * open_cookie (void * cookie, const char * mode,
+                           cookie_io_functions_t functions) {
+  FILE * res = fopencookie (cookie, mode, functions);
+  if (res) setvbuf (res, 0, _IOFBF, codec_buffer_size);
+  return res;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+#ifdef ZLIB
+
+static ssize_t gz_read (void * cookie, char * buffer, size_t size) {
+  return gzread ((gzFile) cookie, buffer, (unsigned) size);
+}
+
+static ssize_t gz_write (void * cookie, const char * buffer, size_t size) {
+  return gzwrite ((gzFile) cookie, buffer, (unsigned) size);
+}
+
+static int gz_close (void * cookie) {
+  return gzclose ((gzFile) cookie) == Z_OK ? 0 : EOF;
+}
+
+static FILE * open_gz (const char * path, bool writing) {
+  gzFile gz = gzopen (path, writing ? "wb" : "rb");
+  if (!gz) return 0;
+  gzbuffer (gz, codec_buffer_size);
+  cookie_io_functions_t functions = { gz_read, gz_write, 0, gz_close };
+  FILE * res = open_cookie (gz, writing ? "w" : "r", functions);
+  if (!res) gzclose (gz);
+  return res;
+}
+
+#endif
+/*------------------------------------------------------------------------*/
+#ifdef LZMA
+
+struct XZ {
+  FILE * file;
+  lzma_stream stream;
+  bool writing, eof;
+  uint8_t buffer[codec_buffer_size];
+};
+
+// Write out compressed data and reset the output buffer.
+
+static bool xz_flush (XZ * xz) {
+  lzma_stream & s = xz->stream;
+  const size_t bytes = sizeof xz->buffer - s.avail_out;
+  if (bytes && fwrite (xz->buffer, 1, bytes, xz->file) != bytes)
+    return false;
+  s.next_out = xz->buffer;
+  s.avail_out = sizeof xz->buffer;
+  return true;
+}
+
+static ssize_t xz_write (void * cookie, const char * buffer, size_t size) {
+  XZ * xz = (XZ *) cookie;
+  lzma_stream & s = xz->stream;
+  assert (xz->writing);
+  s.next_in = (const uint8_t *) buffer;
+  s.avail_in = size;
+  while (s.avail_in) {
+    if (lzma_code (&s, LZMA_RUN) != LZMA_OK) return 0;
+    if (!s.avail_out && !xz_flush (xz)) return 0;
+  }
+  return size;
+}
+
+static ssize_t xz_read (void * cookie, char * buffer, size_t size) {
+  XZ * xz = (XZ *) cookie;
+  lzma_stream & s = xz->stream;
+  assert (!xz->writing);
+  s.next_out = (uint8_t *) buffer;
+  s.avail_out = size;
+  while (s.avail_out && !xz->eof) {
+    if (!s.avail_in) {
+      s.next_in = xz->buffer;
+      s.avail_in = fread (xz->buffer, 1, sizeof xz->buffer, xz->file);
+      if (ferror (xz->file)) return -1;
+    }
+    const lzma_action action = feof (xz->file) ? LZMA_FINISH : LZMA_RUN;
+    const lzma_ret ret = lzma_code (&s, action);
+    if (ret == LZMA_STREAM_END) xz->eof = true;
+    else if (ret != LZMA_OK) return -1;
+  }
+  return size - s.avail_out;
+}
+
+static int xz_close (void * cookie) {
+  XZ * xz = (XZ *) cookie;
+  lzma_stream & s = xz->stream;
+  int res = 0;
+  if (xz->writing) {
+    lzma_ret ret;
+    do {
+      ret = lzma_code (&s, LZMA_FINISH);
+      if (ret != LZMA_OK && ret != LZMA_STREAM_END) { res = EOF; break; }
+      if ((!s.avail_out || ret == LZMA_STREAM_END) && !xz_flush (xz)) {
+        res = EOF;
+        break;
+      }
+    } while (ret != LZMA_STREAM_END);
+  }
+  lzma_end (&s);
+  if (fclose (xz->file)) res = EOF;
+  delete xz;
+  return res;
+}
+
+// Writes '.xz' files (with the default compression level of 'xz') and
+// reads both '.xz' and the legacy '.lzma' format.
+
+static FILE * open_xz (const char * path, bool writing, bool legacy) {
+  FILE * file = fopen (path, writing ? "w" : "r");
+  if (!file) return 0;
+  XZ * xz = new XZ;
+  const lzma_stream init = LZMA_STREAM_INIT;
+  xz->file = file;
+  xz->stream = init;
+  xz->writing = writing;
+  xz->eof = false;
+  lzma_ret ret;
+  if (writing) {
+    assert (!legacy);
+    ret = lzma_easy_encoder (&xz->stream, 6, LZMA_CHECK_CRC64);
+    xz->stream.next_out = xz->buffer;
+    xz->stream.avail_out = sizeof xz->buffer;
+  } else if (legacy)
+    ret = lzma_alone_decoder (&xz->stream, UINT64_MAX);
+  else
+    ret = lzma_stream_decoder (&xz->stream,
+                               UINT64_MAX, LZMA_CONCATENATED);
+  FILE * res = 0;
+  if (ret == LZMA_OK) {
+    cookie_io_functions_t functions = { xz_read, xz_write, 0, xz_close };
+    res = open_cookie (xz, writing ? "w" : "r", functions);
+  }
+  if (!res) {
+    lzma_end (&xz->stream);
+    fclose (file);
+    delete xz;
+  }
+  return res;
+}
+
+#endif
+/*------------------------------------------------------------------------*/
+
+bool File::decompressible (const char * path) {
+#ifdef ZLIB
+  if (has_suffix (path, ".gz")) return true;
+#endif
+#ifdef LZMA
+  if (has_suffix (path, ".xz")) return true;
+  if (has_suffix (path, ".lzma")) return true;
+#endif
+  (void) path;
+  return false;
+}
+
+FILE * File::decompress (const char * path) {
+#ifdef ZLIB
+  if (has_suffix (path, ".gz")) return open_gz (path, false);
+#endif
+#ifdef LZMA
+  if (has_suffix (path, ".xz")) return open_xz (path, false, false);
+  if (has_suffix (path, ".lzma")) return open_xz (path, false, true);
+#endif
+  (void) path;
+  return 0;
+}
+
+FILE * File::compress (const char * path) {
+#ifdef ZLIB
+  if (has_suffix (path, ".gz")) return open_gz (path, true);
+#endif
+#ifdef LZMA
+  if (has_suffix (path, ".xz")) return open_xz (path, true, false);
+#endif
+  (void) path;
+  return 0;
+}
+
+}
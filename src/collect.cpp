@@ -56,9 +56,13 @@ void Internal::remove_falsified_literals (Clause * c) {
 // If there are new units (fixed variables) since the last garbage
 // collection we go over all clauses, mark satisfied ones as garbage and
 // flush falsified literals.  Otherwise if no new units have been generated
-// since the last garbage collection just skip this step.
+// since the last garbage collection just skip this step.  Clauses shrunken
+// to binary clauses are replaced by implicit binary clauses (unless binary
+// clauses are explicit).  Their watched literals are saved on 'binary' if
+// given, since only their watch lists are flushed in incremental garbage
+// collection.  Satisfied binary clauses are deleted right away.
 
-void Internal::mark_satisfied_clauses_as_garbage () {
+void Internal::mark_satisfied_clauses_as_garbage (vector<int> * binary) {
 
   if (last.collect.fixed >= stats.all.fixed) return;
   last.collect.fixed = stats.all.fixed;
@@ -69,7 +73,30 @@ void Internal::mark_satisfied_clauses_as_garbage () {
     if (c->garbage) continue;
     const int tmp = clause_contains_fixed_literal (c);
          if (tmp > 0) mark_garbage (c);
-    else if (tmp < 0) remove_falsified_literals (c);
+    else if (tmp < 0) {
+      remove_falsified_literals (c);
+      if (c->size > 2 || explicit_binaries) continue;
+      if (binary) {
+        binary->push_back (c->literals[0]);
+        binary->push_back (c->literals[1]);
+      }
+      make_binary_implicit (c);
+    }
+  }
+
+  for (auto lit : lits) {
+    Binaries & bs = binary_watches (lit);
+    const auto end = bs.end ();
+    auto j = bs.begin (), i = j;
+    while (i != end) {
+      const Binary & w = *j++ = *i++;
+      if (fixed (lit) <= 0 && fixed (w.blit) <= 0) continue;
+      if (lit < w.blit) delete_binary (lit, w);
+      j--;
+    }
+    if (j == end) continue;
+    bs.resize (j - bs.begin ());
+    shrink_vector (bs);
   }
 }
 
@@ -94,7 +121,7 @@ void Internal::protect_reasons () {
     Var & v = var (lit);
     assert (v.level > 0);
     Clause * reason = v.reason;
-    if (!reason) continue;
+    if (!reason || is_binary_reason (reason)) continue;
     LOG (reason, "protecting assigned %d reason %p", lit, (void*) reason);
     assert (!reason->reason);
     reason->reason = true;
@@ -119,7 +146,7 @@ void Internal::unprotect_reasons () {
     Var & v = var (lit);
     assert (v.level > 0);
     Clause * reason = v.reason;
-    if (!reason) continue;
+    if (!reason || is_binary_reason (reason)) continue;
     LOG (reason, "unprotecting assigned %d reason %p", lit, (void*) reason);
     assert (reason->reason);
     reason->reason = false;
@@ -161,40 +188,65 @@ size_t Internal::flush_occs (int lit) {
 // hidden in 'Clause.collect', which for the root level context of
 // preprocessing is actually redundant.
 
-inline void Internal::flush_watches (int lit, Watches & saved) {
-  assert (saved.empty ());
+// The watched literal 'lit' of the (potentially moved) clause 'c' gets the
+// other watched literal as new blocking literal.
+
+static inline Watch
+flushed_watch (Internal * internal, int lit, Clause * c) {
+  const int new_blit_pos = (c->literals[0] == lit);
+  assert (c->literals[!new_blit_pos] == lit);          /*FW1*/
+  return internal->new_watch (lit, c->literals[new_blit_pos], c);
+}
+
+inline void Internal::flush_watches (int lit) {
   Watches & ws = watches (lit);
-  const const_watch_iterator end = ws.end ();
   watch_iterator j = ws.begin ();
   const_watch_iterator i;
-  for (i = j; i != end; i++) {
-    Watch w = *i;
-    Clause * c = w.clause;
+  for (i = j; i != ws.end (); i++) {
+    Clause * c = watched (*i);
     if (c->collect ()) continue;
-    if (c->moved) c = w.clause = c->copy;
-    w.size = c->size;
-    const int new_blit_pos = (c->literals[0] == lit);
-    assert (c->literals[!new_blit_pos] == lit);        /*FW1*/
-    w.blit = c->literals[new_blit_pos];
-    if (w.binary ()) *j++ = w;
-    else saved.push_back (w);
+    if (c->moved) c = c->copy;
+    *j++ = flushed_watch (this, lit, c);
   }
   ws.resize (j - ws.begin ());
-  for (const auto & w : saved) ws.push_back (w);
-  saved.clear ();
   shrink_vector (ws);
 }
 
+// Number of workers used in garbage collection, i.e., the requested number
+// of threads unless the pool has not been started yet (or can not be).
+
+static unsigned collect_workers (Internal * internal) {
+  return min ((unsigned) internal->opts.collectthreads,
+              internal->workers.size ());
+}
+
+// Flushing the lists of different literals is independent and thus can be
+// split into ranges of variables for the workers (if there are more than
+// one), which only read the clauses.
+
 void Internal::flush_all_occs_and_watches () {
+  const unsigned n = collect_workers (this);
+  if (n > 1) {
+    const bool occs = occurring (), watches = watching ();
+    workers.run (n, [this, n, occs, watches] (unsigned worker) {
+      const int64_t vars = max_var;
+      const int first = 1 + vars * worker / n;
+      const int last = vars * (worker + 1) / n;
+      for (int idx = first; idx <= last; idx++) {
+        if (occs) flush_occs (idx), flush_occs (-idx);
+        if (watches) flush_watches (idx), flush_watches (-idx);
+      }
+    });
+    return;
+  }
+
   if (occurring ())
     for (auto idx : vars)
       flush_occs (idx), flush_occs (-idx);
 
-  if (watching ()) {
-    Watches tmp;
+  if (watching ())
     for (auto idx : vars)
-      flush_watches (idx, tmp), flush_watches (-idx, tmp);
-  }
+      flush_watches (idx), flush_watches (-idx);
 }
 
 /*------------------------------------------------------------------------*/
@@ -206,7 +258,7 @@ void Internal::update_reason_references () {
     if (!active (lit)) continue;
     Var & v = var (lit);
     Clause * c = v.reason;
-    if (!c) continue;
+    if (!c || is_binary_reason (c)) continue;
     LOG (c, "updating assigned %d reason", lit);
     assert (c->reason);
     assert (c->moved);
@@ -253,11 +305,18 @@ void Internal::delete_garbage_clauses () {
 // This is the start of the copying garbage collector using the arena.  At
 // the core is the following function, which copies a clause to the 'to'
 // space of the arena.  Be careful if this clause is a reason of an
-// assignment.  In that case update the reason reference.
+// assignment.  In that case update the reason reference.  With several
+// workers the clause is only marked as moved and actually copied later in
+// 'copy_moved_clauses' (in the same order).
 //
 void Internal::copy_clause (Clause * c) {
   LOG (c, "moving");
   assert (!c->moved);
+  if (collect_workers (this) > 1) {
+    c->moved = true;
+    copying.push_back (c);
+    return;
+  }
   char * p = (char*) c;
   char * q = arena.copy (p, c->bytes ());
   c->copy = (Clause *) q;
@@ -266,6 +325,43 @@ void Internal::copy_clause (Clause * c) {
        c->id, (void*) c, (void*) c->copy);
 }
 
+// Copy the clauses collected in 'copying' in parallel.  Each worker copies
+// a contiguous range of these clauses to a contiguous range of the 'to'
+// space, which starts after the bytes of the ranges of previous workers.
+// The 'copy' field overlaps the literals and thus can only be set after
+// copying the clause, which also copied the 'moved' flag.
+
+void Internal::copy_moved_clauses () {
+  const unsigned n = collect_workers (this);
+  const size_t size = copying.size ();
+  vector<size_t> offsets (n + 1);
+  workers.run (n, [this, n, size, &offsets] (unsigned worker) {
+    size_t sum = 0;
+    const size_t end = size * (worker + 1) / n;
+    for (size_t i = size * worker / n; i != end; i++)
+      sum += copying[i]->bytes ();
+    offsets[worker + 1] = sum;
+  });
+  for (unsigned worker = 0; worker != n; worker++)
+    offsets[worker + 1] += offsets[worker];
+  char * start = arena.claim (offsets[n]);
+  workers.run (n, [this, n, size, start, &offsets] (unsigned worker) {
+    char * q = start + offsets[worker];
+    const size_t end = size * (worker + 1) / n;
+    for (size_t i = size * worker / n; i != end; i++) {
+      Clause * c = copying[i];
+      const size_t bytes = c->bytes ();
+      memcpy (q, c, bytes);
+      Clause * d = (Clause *) q;
+      d->moved = false;
+      c->copy = d;
+      q += bytes;
+    }
+  });
+  LOG ("copied %zd clauses with %u workers", size, n);
+  erase_vector (copying);
+}
+
 // This is the moving garbage collector.
 
 void Internal::copy_non_garbage_clauses () {
@@ -323,10 +419,12 @@ void Internal::copy_non_garbage_clauses () {
     // Our version uses saved phases too.
 
     for (int sign = -1; sign <= 1; sign += 2)
-      for (auto idx : vars)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+      for (auto idx : vars) {
+        const int lit = sign * likely_phase (idx);
+        for (const auto & w : watches (lit))
+          if (!watched (w)->moved && !watched (w)->collect ())
+            copy_clause (watched (w));
+      }
 
   } else {
 
@@ -339,10 +437,12 @@ void Internal::copy_non_garbage_clauses () {
     assert (opts.arenatype == 3);
 
     for (int sign = -1; sign <= 1; sign += 2)
-      for (int idx = queue.last; idx; idx = link (idx).prev)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+      for (int idx = queue.last; idx; idx = link (idx).prev) {
+        const int lit = sign * likely_phase (idx);
+        for (const auto & w : watches (lit))
+          if (!watched (w)->moved && !watched (w)->collect ())
+            copy_clause (watched (w));
+      }
   }
 
   // Do not forget to move clauses which are not watched, which happened in
@@ -352,6 +452,8 @@ void Internal::copy_non_garbage_clauses () {
     if (!c->collect () && !c->moved)
       copy_clause (c);
 
+  if (!copying.empty ()) copy_moved_clauses ();
+
   flush_all_occs_and_watches ();
   update_reason_references ();
 
@@ -397,6 +499,12 @@ void Internal::check_clause_stats () {
     if (!c->redundant) irrbytes += c->bytes ();
     total++;
   }
+  for (auto lit : lits)
+    for (const auto & w : binary_watches (lit)) {
+      if (lit > w.blit) continue;
+      if (w.redundant) redundant++; else irredundant++;
+      total++;
+    }
   assert (stats.current.irredundant == irredundant);
   assert (stats.current.redundant == redundant);
   assert (stats.current.total == total);
@@ -406,8 +514,29 @@ void Internal::check_clause_stats () {
 
 /*------------------------------------------------------------------------*/
 
+// Give back chunks of the slab without live clauses (see 'slab.hpp').  All
+// clauses allocated in the slab are in 'clauses' at this point.
+
+void Internal::release_slab () {
+#ifndef COMPACTWATCHES
+  vector<char *> used;
+  if (!slab.empty ())
+    for (const auto & c : clauses)
+      if (c->slab && !arena.contains ((char *) c))
+        used.push_back ((char *) c);
+  slab.release (used);
+#endif
+}
+
+// With compact watches all clauses are allocated in the arena and their
+// memory is only reclaimed by the moving garbage collector.
+
 bool Internal::arenaing () {
+#ifdef COMPACTWATCHES
+  return true;
+#else
   return opts.arena && (stats.collections > 1);
+#endif
 }
 
 void Internal::garbage_collection () {
@@ -415,13 +544,179 @@ void Internal::garbage_collection () {
   START (collect);
   report ('G', 1);
   stats.collections++;
+  workers.reserve (opts.collectthreads);
+  const double busy = workers.busy, wall = workers.wall;
   mark_satisfied_clauses_as_garbage ();
   if (!protected_reasons) protect_reasons ();
   if (arenaing ()) copy_non_garbage_clauses ();
   else delete_garbage_clauses ();
+  if (collect_workers (this) > 1)
+    PHASE ("collect", stats.collections,
+      "speedup %.2f with %u threads flushing and copying in %.2f seconds",
+      relative (workers.busy - busy, workers.wall - wall),
+      collect_workers (this), workers.wall - wall);
+  check_clause_stats ();
+  check_var_stats ();
+  unprotect_reasons ();
+  release_slab ();
+  report ('C', 1);
+  STOP (collect);
+}
+
+
+/*------------------------------------------------------------------------*/
+
+// Incremental garbage collection ('opts.collectinc') used in 'reduce'
+// avoids the pause of flushing all watches and copying all clauses, which
+// for huge clause databases takes seconds.  Instead each call only
+// visits 'opts.collectincbytes' of clause memory in the next region of the
+// arena (see 'Arena::region') and as much in the next slice of 'clauses'
+// allocated outside of the arena.  Garbage clauses found are deleted and
+// the other clauses in the arena region are moved down in place, which
+// keeps the arena compact without needing a 'to' space.  Since watches of
+// a clause are only in the watch lists of its two watched literals, only
+// those lists need to be flushed.  Garbage not visited remains until
+// one of the next calls reaches it.
+
+struct moved_clause {
+  Clause * from, * to;
+  bool operator < (const moved_clause & other) const {
+    return from < other.from;
+  }
+};
+
+// Returns the new address of a clause in the region or zero if the clause
+// was deleted.  The moved clauses are sorted by their old address.
+
+static Clause * moved_to (const vector<moved_clause> & moved, Clause * c) {
+  const moved_clause key = { c, 0 };
+  auto i = lower_bound (moved.begin (), moved.end (), key);
+  if (i == moved.end () || i->from != c) return 0;
+  return i->to;
+}
+
+void Internal::incremental_garbage_collection () {
+  if (unsat) return;
+  assert (watching ()), assert (!occurring ());
+  START (collect);
+  report ('G', 1);
+  stats.collections++;
+  stats.collectinc++;
+  vector<int> flushing;
+  mark_satisfied_clauses_as_garbage (&flushing);
+  if (!protected_reasons) protect_reasons ();
+
+  const size_t budget = opts.collectincbytes;
+  char * start, * end;
+  arena.region (budget, start, end);
+
+  // Find the clauses in the arena region and the garbage clauses in the
+  // next slice of clauses outside of the arena.  This only needs to read
+  // the headers of clauses in the slice.
+  //
+  vector<Clause *> region, collected;
+  size_t first = last.collect.clause, next = 0, sliced = 0;
+  if (first >= clauses.size ()) first = 0;
+  for (size_t i = 0; i != clauses.size (); i++) {
+    Clause * c = clauses[i];
+    const char * p = (const char *) c;
+    if (start <= p && p < end) { region.push_back (c); continue; }
+    if (arena.allocated (c) || i < first || sliced >= budget) continue;
+    sliced += c->bytes ();
+    next = i + 1;
+    if (!c->collect ()) continue;
+    flushing.push_back (c->literals[0]);
+    flushing.push_back (c->literals[1]);
+    collected.push_back (c);
+    clauses[i] = 0;
+  }
+  if (sliced < budget) next = 0;
+
+  // Move the non-garbage clauses of the region down in address order.
+  // Garbage clauses in the region are deleted before clauses moved later
+  // can overwrite them (their memory is reclaimed by compacting).
+  //
+  rsort (region.begin (), region.end (), pointer_rank ());
+  vector<moved_clause> moved;
+  size_t collected_bytes = 0, collected_clauses = collected.size ();
+  for (const auto & c : region) {
+    flushing.push_back (c->literals[0]);
+    flushing.push_back (c->literals[1]);
+    const size_t bytes = c->bytes ();
+    if (c->collect ()) {
+      collected_bytes += bytes, collected_clauses++;
+      delete_clause (c);
+    } else {
+      const moved_clause m = { c, (Clause *) arena.slide ((char *) c, bytes) };
+      moved.push_back (m);
+    }
+  }
+
+  // Flush watches of the watched literals of visited clauses.
+  //
+  sort (flushing.begin (), flushing.end ());
+  flushing.resize (unique (flushing.begin (), flushing.end ()) -
+                   flushing.begin ());
+  for (const auto & lit : flushing) {
+    Watches & ws = watches (lit);
+    watch_iterator j = ws.begin ();
+    const_watch_iterator i;
+    for (i = j; i != ws.end (); i++) {
+      Clause * c = watched (*i);
+      const char * p = (const char *) c;
+      if (start <= p && p < end) {
+        if (!(c = moved_to (moved, c))) continue;
+      } else if (c->collect ()) continue;
+      *j++ = flushed_watch (this, lit, c);
+    }
+    ws.resize (j - ws.begin ());
+    shrink_vector (ws);
+  }
+
+  // Update reason references to moved clauses.
+  //
+  for (const auto & lit : trail) {
+    if (!active (lit)) continue;
+    Var & v = var (lit);
+    if (is_binary_reason (v.reason)) continue;
+    const char * p = (const char *) v.reason;
+    if (p < start || end <= p) continue;
+    v.reason = moved_to (moved, v.reason);
+    assert (v.reason);
+  }
+
+  for (const auto & c : collected) {
+    collected_bytes += c->bytes ();
+    delete_clause (c);
+  }
+
+  // Flush deleted clauses from 'clauses' and update moved ones.
+  //
+  const auto eoc = clauses.end ();
+  auto j = clauses.begin (), i = j;
+  for (; i != eoc; i++) {
+    if (i - clauses.begin () == (ptrdiff_t) next)
+      next = j - clauses.begin ();
+    Clause * c = *i;
+    if (!c) continue;
+    const char * p = (const char *) c;
+    if (start <= p && p < end && !(c = moved_to (moved, c))) continue;
+    *j++ = c;
+  }
+  clauses.resize (j - clauses.begin ());
+  last.collect.clause = next;
+
+  const bool completed = arena.compact (end);
+
+  PHASE ("collect", stats.collections,
+    "collected %zd bytes of %zd garbage clauses and moved %zd clauses%s",
+    collected_bytes, collected_clauses, moved.size (),
+    completed ? " (arena compacted)" : "");
+
   check_clause_stats ();
   check_var_stats ();
   unprotect_reasons ();
+  release_slab ();
   report ('C', 1);
   STOP (collect);
 }
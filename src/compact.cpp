@@ -218,9 +218,16 @@ void Internal::compact () {
   // Map the blocking literals in all watches.
   //
   if (!wtab.empty ())
-    for (auto lit : lits)
-      for (auto & w : watches (lit))
+    for (auto lit : lits) {
+      for (auto & w : watches (lit)) {
         w.blit = mapper.map_lit (w.blit);
+#ifndef COMPACTWATCHES
+        if (w.tern) w.tern = mapper.map_lit (w.tern);
+#endif
+      }
+      for (auto & w : binary_watches (lit))
+        w.blit = mapper.map_lit (w.blit);
+    }
 
   // We first flush inactive variables and map the links in the queue.  This
   // has to be done before we map the actual links data structure 'links'.
@@ -880,7 +880,11 @@ void Internal::condition (bool update_limits) {
     "started after %" PRIu64 " conflicts limited by %ld propagations",
     stats.conflicts, limit);
 
+  // Candidates and occurrences are clauses, including binary clauses.
+  //
+  make_binaries_explicit ();
   long blocked = condition_round (limit);
+  make_binaries_implicit ();
 
   STOP_SIMPLIFIER (condition, CONDITION);
   report ('g', !blocked);
@@ -16,6 +16,71 @@ struct DFS {
   DFS () : idx (0), min (0) { }
 };
 
+// For LRAT proofs we need the binary clauses on paths in the binary
+// implication graph from members of an SCC to its representative.  We find
+// them by backward breadth first search from 'root' restricted to the SCC.
+// While the SCC is on the 'scc' stack (before its members are marked as
+// traversed), its members are exactly the literals with depth first search
+// index at least 'min' which are not traversed yet.  The binary clause
+// through which a literal reaches 'root' first is saved in 'reasons' as
+// its other literal 'parent' and its identifier.
+
+struct DecomposeReason {
+  int parent;
+  clause_id_t id;
+};
+
+static void
+decompose_bfs (Internal * internal, const DFS * dfs, unsigned min,
+               int root, DecomposeReason * reasons, vector<int> & work)
+{
+  assert (work.empty ());
+  work.push_back (root);
+  for (size_t i = 0; i < work.size (); i++) {
+    const int parent = work[i];
+    for (const auto & w : internal->binary_watches (parent)) {
+      const int child = -w.blit;
+      if (child == root) continue;
+      const DFS & child_dfs = dfs[internal->vlit (child)];
+      if (child_dfs.idx < min || child_dfs.min == TRAVERSED) continue;
+      DecomposeReason & reason = reasons[internal->vlit (child)];
+      if (reason.parent) continue;
+      reason.parent = parent;
+      reason.id = internal->binary_id (w);
+      work.push_back (child);
+    }
+  }
+}
+
+// Add the binary clauses on the path from 'lit' to 'root' found by
+// 'decompose_bfs' to the chain in reverse order, such that they derive
+// '-lit' from '-root'.  If 'dedup' is true we stop at literals already
+// known to be false, either since they occur in the (marked) derived clause
+// or have been derived before, which as in 'build_chain' is recorded with
+// the 'justified' flags.
+
+static void
+decompose_path (Internal * internal, const DecomposeReason * reasons,
+                int root, int lit, bool dedup)
+{
+  vector<clause_id_t> & chain = internal->chain;
+  const size_t start = chain.size ();
+  while (lit != root) {
+    if (dedup) {
+      if (internal->marked (lit) > 0) break;
+      Flags & f = internal->flags (lit);
+      if (f.justified) break;
+      f.justified = true;
+      internal->justified.push_back (lit);
+    }
+    const DecomposeReason & reason = reasons[internal->vlit (lit)];
+    assert (reason.parent), assert (reason.id);
+    chain.push_back (reason.id);
+    lit = reason.parent;
+  }
+  reverse (chain.begin () + start, chain.end ());
+}
+
 // This performs one round of Tarjan's algorithm, e.g., equivalent literal
 // detection and substitution, on the whole formula.  We might want to
 // repeat it since its application might produce new binary clauses or
@@ -38,6 +103,14 @@ bool Internal::decompose_round () {
   int * reprs = new int[size_dfs];
   clear_n (reprs, size_dfs);
 
+  const bool lrat = proof && opts.lrat;
+  DecomposeReason * reasons = 0;
+  if (lrat) {
+    reasons = new DecomposeReason [size_dfs];
+    clear_n (reasons, size_dfs);
+  }
+  vector<int> bfs;                      // breadth first search for LRAT
+
   int non_trivial_sccs = 0, substituted = 0;
 #ifndef QUIET
   int before = active ();
@@ -72,7 +145,7 @@ bool Internal::decompose_round () {
           // Go over all implied literals, thus need to iterate over all
           // binary watched clauses with the negation of 'parent'.
 
-          Watches & ws = watches (-parent);
+          Binaries & ws = binary_watches (-parent);
 
           // Two cases: Either the node has never been visited before, i.e.,
           // it's depth first search index is zero, then perform the
@@ -91,7 +164,6 @@ bool Internal::decompose_round () {
             unsigned new_min = parent_dfs.min;
 
             for (const auto & w : ws) {
-              if (!w.binary ()) continue;
               const int child = w.blit;
               if (!active (child)) continue;
               const DFS & child_dfs = dfs[vlit (child)];
@@ -117,9 +189,22 @@ bool Internal::decompose_round () {
                 other = scc[--j];
                 if (other == -parent) {
                   LOG ("both %d and %d in one SCC", parent, -parent);
-                  PROOF_TODO (proof, "SCC 1", 41); // TODO(Mario)
+                  if (lrat) {
+                    decompose_bfs (this, dfs, parent_dfs.idx,
+                                   parent, reasons, bfs);
+                    decompose_path (this, reasons, parent, -parent, false);
+                    for (const auto & lit : bfs)
+                      reasons[vlit (lit)].parent = 0;
+                    bfs.clear ();
+                  }
                   assign_unit (parent);
-                  PROOF_TODO (proof, "SCC 2", 42); // TODO(Mario)
+                  if (lrat) {
+                    decompose_bfs (this, dfs, parent_dfs.idx,
+                                   -parent, reasons, bfs);
+                    chain.push_back (var (parent).unit_id);
+                    decompose_path (this, reasons, -parent, parent, false);
+                    bfs.clear ();
+                  }
                   learn_empty_clause ();
                 } else {
                   if (abs (other) < abs (repr)) repr = other;
@@ -131,6 +216,12 @@ bool Internal::decompose_round () {
 
                 LOG ("SCC of representative %d of size %d", repr, size);
 
+                if (lrat && size > 1) {
+                  decompose_bfs (this, dfs, parent_dfs.idx,
+                                 repr, reasons, bfs);
+                  bfs.clear ();
+                }
+
                 do {
                   assert (!scc.empty ());
                   other = scc.back ();
@@ -172,7 +263,6 @@ bool Internal::decompose_round () {
             // graph but keep 'parent' on the stack for 'post-fix' work.
 
             for (const auto & w : ws) {
-              if (!w.binary ()) continue;
               const int child = w.blit;
               if (!active (child)) continue;
               const DFS & child_dfs = dfs[vlit (child)];
@@ -187,6 +277,7 @@ bool Internal::decompose_round () {
 
   erase_vector (work);
   erase_vector (scc);
+  erase_vector (bfs);
   delete [] dfs;
 
   // Only keep the representatives 'repr' mapping.
@@ -198,33 +289,16 @@ bool Internal::decompose_round () {
 
   bool new_unit = false, new_binary_clause = false;
 
-  vector<Clause*> postponed_garbage;
+  // Copy the substituted clause 'c' to 'clause'.  Substitute literals if
+  // they have a different representative.  Skip duplicates and false
+  // literals.  If a literal occurs in both phases or is assigned to true the
+  // clause is satisfied and the result is 'true'.
 
-  // Now go over all clauses and find clause which contain literals that
-  // should be substituted by their representative.
-
-  size_t clauses_size = clauses.size (), garbage = 0, replaced = 0;
-  for (size_t i = 0; substituted && !unsat && i < clauses_size; i++) {
-    Clause * c = clauses[i];
-    if (c->garbage) continue;
-    int j, size = c->size;
-    for (j = 0; j < size; j++) {
-      const int lit = c->literals[j];
-      if (reprs [ vlit (lit) ] != lit) break;
-    }
-
-    if (j == size) continue;
-
-    replaced++;
-    LOG (c, "first substituted literal %d in", substituted);
-
-    // Now copy the result to 'clause'.  Substitute literals if they have a
-    // different representative.  Skip duplicates and false literals.  If a
-    // literal occurs in both phases or is assigned to true the clause is
-    // satisfied and can be marked as garbage.
+  auto substitute = [&] (const Clause * c) {
 
     assert (clause.empty ());
     bool satisfied = false;
+    const int size = c->size;
 
     for (int k = 0; !satisfied && k < size; k++) {
       const int lit = c->literals[k];
@@ -247,27 +321,139 @@ bool Internal::decompose_round () {
       }
     }
 
+    // The substituted clause is derived from 'c' by resolving each
+    // substituted literal with the binary clauses on the path to its
+    // representative and each false literal with its unit clause.
+
+    if (!satisfied && lrat) {
+      assert (chain.empty ());
+      for (int k = 0; k < size; k++) {
+        const int lit = c->literals[k];
+        int other = lit;
+        if (!val (lit)) {
+          other = reprs [vlit (lit)];
+          if (!val (other)) {
+            if (other != lit)
+              decompose_path (this, reasons, other, lit, true);
+            continue;
+          }
+        }
+        assert (val (other) < 0);
+        Flags & f = flags (other);
+        if (!f.justified) {
+          f.justified = true;
+          justified.push_back (other);
+          chain.push_back (var (other).unit_id);
+        }
+        if (other != lit)
+          decompose_path (this, reasons, other, lit, true);
+      }
+      chain.push_back (c->id);
+      for (const auto & lit : justified)
+        flags (lit).justified = false;
+      justified.clear ();
+    }
+
+    for (const auto & lit : clause)
+      unmark (lit);
+
+    return satisfied;
+  };
+
+  size_t clauses_size = clauses.size (), garbage = 0, replaced = 0;
+
+  // Binary clauses with substituted literals are removed from the watch
+  // lists before they are substituted, since that adds new binary clauses.
+  // They are only deleted at the end, since they might still be needed in
+  // the LRAT chains of paths to representatives (even if not satisfied
+  // after substitution because of frozen literals).
+
+  vector<pair<int, Binary>> binaries;
+
+  for (auto lit : lits) {
+    if (!substituted) break;
+    Binaries & bs = binary_watches (lit);
+    const auto end = bs.end ();
+    auto j = bs.begin (), i = j;
+    while (i != end) {
+      const Binary w = *j++ = *i++;
+      const int other = w.blit;
+      if (reprs [vlit (lit)] == lit && reprs [vlit (other)] == other)
+        continue;
+      if (lit < other) binaries.push_back ({lit, w});
+      j--;
+    }
+    bs.resize (j - bs.begin ());
+  }
+
+  for (const auto & b : binaries) {
+    if (unsat) break;
+    const int lit = b.first;
+    const Binary & w = b.second;
+    replaced++;
+    Clause * c = binary_clause (&binary_reason_clause,
+                                lit, w.blit, binary_id (w), w.redundant);
+    LOG (c, "substituting");
+    garbage++;
+    if (substitute (c)) LOG (c, "satisfied after substitution (postponed)");
+    else if (!clause.size ()) {
+      LOG ("learned empty clause during decompose");
+      learn_empty_clause ();
+    } else if (clause.size () == 1) {
+      LOG (c, "unit %d after substitution", clause[0]);
+      assign_unit (clause[0]);
+      new_unit = true;
+    } else {
+      new_binary_clause = true;
+      new_derived_binary_clause (w.redundant);
+    }
+    clause.clear ();
+  }
+
+  vector<Clause*> postponed_garbage;
+
+  // Now go over all clauses and find clause which contain literals that
+  // should be substituted by their representative.
+
+  for (size_t i = 0; substituted && !unsat && i < clauses_size; i++) {
+    Clause * c = clauses[i];
+    if (c->garbage) continue;
+    int j, size = c->size;
+    for (j = 0; j < size; j++) {
+      const int lit = c->literals[j];
+      if (reprs [ vlit (lit) ] != lit) break;
+    }
+
+    if (j == size) continue;
+
+    replaced++;
+    LOG (c, "first substituted literal %d in", substituted);
+
+    const bool satisfied = substitute (c);
+
     if (satisfied) {
       LOG (c, "satisfied after substitution (postponed)");
       postponed_garbage.push_back (c);
       garbage++;
     } else if (!clause.size ()) {
       LOG ("learned empty clause during decompose");
-      PROOF_TODO (proof, "decompose empty", 43); // TODO(Mario)
       learn_empty_clause ();
     } else if (clause.size () == 1) {
       LOG (c, "unit %d after substitution", clause[0]);
-      PROOF_TODO (proof, "decompose unit", 44); // TODO(Mario)
       assign_unit (clause[0]);
       mark_garbage (c);
       new_unit = true;
       garbage++;
+    } else if (clause.size () == 2) {
+      LOG ("new binary clause after substitution");
+      new_binary_clause = true;
+      new_clause_as (c);
+      mark_garbage (c);
+      garbage++;
     } else if (c->literals[0] != clause[0] ||
                c->literals[1] != clause[1]) {
       LOG ("need new clause since at least one watched literal changed");
-      if (clause.size () == 2) new_binary_clause = true;
       size_t d_clause_idx = clauses.size ();
-      PROOF_TODO (proof, "decompose new", 45); // TODO(Mario)
       Clause * d = new_clause_as (c);
       assert (clauses[d_clause_idx] == d);
       clauses[d_clause_idx] = c;
@@ -280,12 +466,6 @@ bool Internal::decompose_round () {
       if (!c->redundant) mark_removed (c);
       clause_id_t id = next_clause_id();
       if (proof) {
-        // for (const_literal_iterator i = c->begin (); i != c->end (); i++) {
-        //   int id = var (*i).unit_id;
-        //   if (id) chain.push_back (id);
-        // }
-        // chain.push_back (c->id);
-        PROOF_TODO (proof, "decompose shrink", 46); // TODO(Mario)
         proof->add_derived_clause (id, clause, false, -1);
         proof->delete_clause (c);
       }
@@ -295,18 +475,12 @@ bool Internal::decompose_round () {
       c->id = id;
       int flushed = c->size - (int) l;
       if (flushed) {
-        if (l == 2) new_binary_clause = true;
         LOG ("flushed %d literals", flushed);
         (void) shrink_clause (c, l);
       } else if (likely_to_be_kept_clause (c)) mark_added (c);
       LOG (c, "substituted");
     }
-    while (!clause.empty ()) {
-      int lit = clause.back ();
-      clause.pop_back ();
-      assert (marked (lit) > 0);
-      unmark (lit);
-    }
+    clause.clear ();
   }
 
   if (!unsat && !postponed_garbage.empty ()) {
@@ -317,6 +491,10 @@ bool Internal::decompose_round () {
   }
   erase_vector (postponed_garbage);
 
+  for (const auto & b : binaries)
+    delete_binary (b.first, b.second);
+  erase_vector (binaries);
+
   PHASE ("decompose",
     stats.decompositions,
     "%zd clauses replaced %.2f%% producing %zd garbage clauses %.2f%%",
@@ -354,6 +532,7 @@ bool Internal::decompose_round () {
   }
 
   delete [] reprs;
+  if (reasons) delete [] reasons;
 
   flush_all_occs_and_watches ();  // particularly the 'blit's
 
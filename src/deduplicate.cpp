@@ -6,7 +6,7 @@ namespace CaDiCaL {
 // or 'vivify' might produce duplicated binary clauses.  They can not be
 // found in 'subsume' nor 'vivify' since we explicitly do not consider
 // binary clauses as candidates to be shrunken or subsumed.  They are
-// detected here by a simple scan of watch lists and then marked as garbage.
+// detected here by a simple scan of binary watch lists and then deleted.
 // This is actually also quite fast.
 
 // Further it might also be possible that two binary clauses can be resolved
@@ -45,49 +45,46 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
       const int lit = sign * idx;       // Consider all literals.
 
       assert (stack.empty ());
-      Watches & ws = watches (lit);
+      Binaries & ws = binary_watches (lit);
 
-      // We are removing references to garbage clause. Thus no 'auto'.
+      // Duplicated binary clauses are deleted immediately, which includes
+      // removing the watch of the other literal.  Thus no 'auto'.
 
-      const const_watch_iterator end = ws.end ();
-      watch_iterator j = ws.begin ();
-      const_watch_iterator i;
+      const const_binary_iterator end = ws.end ();
+      binary_iterator j = ws.begin ();
+      const_binary_iterator i;
 
       for (i = j; !unit && i != end; i++) {
-        Watch w = *j++ = *i;
-        if (!w.binary ()) continue;
+        Binary w = *j++ = *i;
         int other = w.blit;
         const int tmp = marked (other);
-        Clause * c = w.clause;
 
         if (tmp > 0) {                  // Found duplicated binary clause.
 
-          if (c->garbage) { j--; continue; }
-          LOG (c, "found duplicated");
+          LOG ("found duplicated binary clause %d %d", lit, other);
 
           // The previous identical clause 'd' might be redundant and if the
-          // second clause 'c' is not (so irredundant), then we have to keep
-          // 'c' instead of 'd', thus we search for it and replace it.
+          // second clause 'w' is not (so irredundant), then we have to keep
+          // 'w' instead of 'd', thus we search for it and replace it.
 
-          if (!c->redundant) {
-            watch_iterator k;
+          if (!w.redundant) {
+            binary_iterator k;
             for (k = ws.begin ();;k++) {
               assert (k != i);
-              if (!k->binary ()) continue;
-              if (k->blit != other) continue;
-              Clause * d = k->clause;
-              if (d->garbage) continue;
-              c = d;
-              break;
+              if (k->blit == other) break;
             }
+            const Binary d = *k;
             *k = w;
+            w = d;
           }
 
-          LOG (c, "mark garbage duplicated");
+          LOG ("deleting duplicated %s binary clause %d %d",
+            w.redundant ? "redundant" : "irredundant", lit, other);
           stats.subsumed++;
           stats.deduplicated++;
           subsumed++;
-          mark_garbage (c);
+          delete_binary (lit, w);
+          remove_binary_watch (other, lit, w);
           j--;
 
         } else if (tmp < 0) {           // Hyper unary resolution.
@@ -96,26 +93,28 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
             lit, -other, lit, other, lit);
           unit = lit;
           chain.clear ();
-          chain.push_back (c->id);
+          chain.push_back (binary_id (w));
           // We've forgotten where the other binary clause is, so go find it again
-          for (watch_iterator k = ws.begin ();;k++) {
+          for (binary_iterator k = ws.begin ();;k++) {
             assert (k != i);
-            if (!k->binary ()) continue;
             if (k->blit != -other) continue;
-            chain.push_back (k->clause->id);
+            chain.push_back (binary_id (*k));
             break;
           }
-
-          j = ws.begin ();              // Flush 'ws'.
           units++;
 
         } else {
-          if (c->garbage) continue;
           mark (other);
           stack.push_back (other);
         }
       }
 
+      // The binary clauses containing the unit are kept until they are
+      // deleted as satisfied clauses during the next garbage collection.
+
+      while (i != end)
+        *j++ = *i++;
+
       if (j == ws.begin ()) erase_vector (ws);
       else if (j != end)
         ws.resize (j - ws.begin ());    // Shrink watchers.
@@ -78,6 +78,7 @@ bool Internal::eliminating () {
 void
 Internal::elim_update_added_clause (Eliminator & eliminator, Clause * c) {
   assert (!c->redundant);
+  elim_touched_clause (eliminator, c);
   ElimSchedule & schedule = eliminator.schedule;
   for (const auto & lit : *c) {
     if (!active (lit)) continue;
@@ -109,6 +110,7 @@ Internal::elim_update_removed_clause (Eliminator & eliminator,
                                       Clause * c, int except)
 {
   assert (!c->redundant);
+  elim_touched_clause (eliminator, c);
   for (const auto & lit : *c) {
     if (lit == except) continue;
     assert (lit != -except);
@@ -149,12 +151,12 @@ void Internal::elim_propagate (Eliminator & eliminator, int root) {
         mark_garbage (c);
       } else if (!unit) {
         LOG ("empty clause during elimination propagation of %d", lit);
-        PROOF_TODO (proof, "elim propagate empty", 50); // TODO(Mario)
+        build_unit_chain (0, c);
         learn_empty_clause ();
         break;
       } else if (unit != INT_MIN) {
         LOG ("new unit %d during elimination propagation of %d", unit, lit);
-        PROOF_TODO (proof, "elim propagate unit", 51); // TODO(Mario)
+        build_unit_chain (unit, c);
         assign_unit (unit);
         work.push_back (unit);
       }
@@ -176,7 +178,9 @@ void Internal::elim_propagate (Eliminator & eliminator, int root) {
 // to HyoJung Han, Fabio Somenzi, SAT'09.  Basically while resolving two
 // clauses we test the resolvent to be smaller than one of the antecedents.
 // If this is the case the pivot can be removed from the antecedent
-// on-the-fly and the resolution can be skipped during elimination.
+// on-the-fly and the resolution can be skipped during elimination.  The
+// strengthened clause is the resolvent, thus its LRAT chain is the one
+// built in 'resolve_clauses'.
 
 void Internal::elim_on_the_fly_self_subsumption (Eliminator & eliminator,
                                                  Clause * c, int pivot)
@@ -192,7 +196,6 @@ void Internal::elim_on_the_fly_self_subsumption (Eliminator & eliminator,
     if (tmp < 0) continue;
     clause.push_back (lit);
   }
-  PROOF_TODO (proof, "self subsumption", 52); // TODO(Mario)
   Clause * r = new_resolved_irredundant_clause ();
   elim_update_added_clause (eliminator, r);
   clause.clear ();
@@ -263,7 +266,7 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
     const signed char tmp = val (lit);
     if (tmp > 0) { satisfied = lit; break; }
     else if (tmp < 0) {
-      if (proof) chain.push_back (var (lit).unit_id);
+      if (proof) chain.push_back (var (lit).unit_id), mark (lit);
       continue;
     }
     else mark (lit), clause.push_back (lit), s++;
@@ -272,7 +275,7 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
     LOG (c, "satisfied by %d antecedent", satisfied);
     elim_update_removed_clause (eliminator, c, satisfied);
     mark_garbage (c);
-    clause.clear ();
+    clause.clear (), chain.clear ();
     unmark (c);
     return false;
   }
@@ -287,7 +290,8 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
     signed char tmp = val (lit);
     if (tmp > 0) { satisfied = lit; break; }
     else if (tmp < 0) {
-      if (proof) chain.push_back (var (lit).unit_id);
+      // Falsified literals in both antecedents need only one unit.
+      if (proof && !marked (lit)) chain.push_back (var (lit).unit_id);
       continue;
     }
     else if ((tmp = marked (lit)) < 0) { tautological = lit; break; }
@@ -302,7 +306,7 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
     LOG (d, "satisfied by %d antecedent", satisfied);
     elim_update_removed_clause (eliminator, d, satisfied);
     mark_garbage (d);
-    clause.clear ();
+    clause.clear (), chain.clear ();
     return false;
   }
 
@@ -310,7 +314,7 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
   LOG (d, "second antecedent");
 
   if (tautological) {
-    clause.clear ();
+    clause.clear (), chain.clear ();
     LOG ("resolvent tautological on %d", tautological);
     return false;
   }
@@ -343,7 +347,7 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
   if (s > size && t > size) {
     assert (s == size + 1);
     assert (t == size + 1);
-    clause.clear (), chain.clear ();
+    clause.clear ();
     elim_on_the_fly_self_subsumption (eliminator, c, pivot);
     LOG (d, "double pivot %d on-the-fly self-subsuming resolution", -pivot);
     stats.elimotfsub++;
@@ -359,7 +363,7 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
 
   if (s > size) {
     assert (s == size + 1);
-    clause.clear (), chain.clear ();
+    clause.clear ();
     elim_on_the_fly_self_subsumption (eliminator, c, pivot);
     return false;
   }
@@ -368,7 +372,7 @@ bool Internal::resolve_clauses (Eliminator & eliminator,
 
   if (t > size) {
     assert (t == size + 1);
-    clause.clear (), chain.clear ();
+    clause.clear ();
     elim_on_the_fly_self_subsumption (eliminator, d, -pivot);
     return false;
   }
@@ -403,6 +407,10 @@ Internal::elim_resolvents_are_bounded (Eliminator & eliminator, int pivot)
   if (!pos || !neg) return lim.elimbound >= 0;
   const int64_t bound = pos + neg + lim.elimbound;
 
+  bool bounded;
+  if (!substitute && elim_checked_resolvents (eliminator, pivot, bounded))
+    return bounded;
+
   LOG ("checking number resolvents on %d bounded by "
     "%" PRId64 " = %" PRId64 " + %" PRId64 " + %" PRId64,
     pivot, bound, pos, neg, lim.elimbound);
@@ -450,6 +458,194 @@ Internal::elim_resolvents_are_bounded (Eliminator & eliminator, int pivot)
   return true;
 }
 
+/*------------------------------------------------------------------------*/
+
+// Checking whether the number of resolvents is bounded is the most costly
+// part of elimination, but only reads the clauses of the candidate unless
+// it finds satisfied clauses, units or on-the-fly strengthening.  Thus with
+// 'opts.elimthreads' larger than one the next candidates in the schedule
+// are checked by the workers in parallel, without gates and aborting on
+// the first such side effect.  The candidates are still tried to be
+// eliminated sequentially in the order of the schedule.  The result of a
+// check is only used instead of 'elim_resolvents_are_bounded' if no gate
+// was found and no clause with the candidate was added, removed or
+// strengthened and no unit was found since the check.  Then the result
+// and the statistics are exactly the same as without parallel checking.
+
+// Invalidate the checks of the variables of an added, removed or
+// strengthened clause.
+
+void Internal::elim_touched_clause (Eliminator & eliminator, Clause * c) {
+  if (eliminator.checked.empty ()) return;
+  for (const auto & lit : *c) {
+    const unsigned pos = eliminator.checked[abs (lit)];
+    if (pos) eliminator.checks[pos - 1].valid = false;
+  }
+}
+
+void Internal::elim_reset_checks (Eliminator & eliminator) {
+  for (const auto & check : eliminator.checks)
+    eliminator.checked[abs (check.pivot)] = 0;
+  eliminator.checks.clear ();
+}
+
+// This is the same as flushing the occurrence lists and sorting them in
+// 'try_to_eliminate_variable' followed by 'elim_resolvents_are_bounded'
+// without gates, but on copies of the occurrence lists and with its own
+// marks, since it is run concurrently by the workers.  It returns 'false'
+// if the check has to be performed sequentially.
+
+bool Internal::elim_check_resolvents (ElimCheck & check,
+                                      vector<signed char> & marks) {
+  int pivot = check.pivot;
+  vector<Clause *> ps, ns;
+  for (const auto & c : occs (pivot))
+    if (!c->collect ()) ps.push_back (c);
+  for (const auto & c : occs (-pivot))
+    if (!c->collect ()) ns.push_back (c);
+  if (ps.size () > ns.size ()) { pivot = -pivot; swap (ps, ns); }
+  check.pivot = pivot;
+
+  const int64_t pos = ps.size ();
+  const int64_t neg = ns.size ();
+  if (!pos || neg > opts.elimocclim) return false;
+  const int64_t bound = pos + neg + lim.elimbound;
+
+  stable_sort (ps.begin (), ps.end (), clause_smaller_size ());
+  stable_sort (ns.begin (), ns.end (), clause_smaller_size ());
+
+  int64_t resolvents = 0;
+  check.resolutions = 0;
+  check.bounded = false;
+
+  for (const auto & first : ps) {
+    for (const auto & second : ns) {
+      check.resolutions++;
+      Clause * c = first, * d = second;
+      int p = pivot;
+      if (c->size > d->size) { p = -p; swap (c, d); }
+      int64_t size = 0, s = 0, t = 0;
+      bool satisfied = false, tautological = false;
+      for (const auto & lit : *c) {
+        if (lit == p) { s++; continue; }
+        const signed char tmp = val (lit);
+        if (tmp > 0) { satisfied = true; break; }
+        if (tmp < 0) continue;
+        marks[abs (lit)] = sign (lit);
+        size++, s++;
+      }
+      if (!satisfied) {
+        for (const auto & lit : *d) {
+          if (lit == -p) { t++; continue; }
+          const signed char tmp = val (lit);
+          if (tmp > 0) { satisfied = true; break; }
+          if (tmp < 0) continue;
+          const int mark = marks[abs (lit)] * sign (lit);
+          if (mark < 0) { tautological = true; break; }
+          if (!mark) size++;
+          t++;
+        }
+      }
+      for (const auto & lit : *c)
+        marks[abs (lit)] = 0;
+      if (satisfied) return false;
+      if (tautological) continue;
+      if (size < 2 || s > size || t > size) return false;
+      if (size > opts.elimclslim) return true;
+      if (++resolvents > bound) return true;
+    }
+  }
+
+  check.bounded = true;
+  return true;
+}
+
+// Check the candidate 'idx' just removed from the schedule and the next
+// unchecked candidates (in schedule order) in parallel, one per worker.
+// Checking more candidates ahead does not pay off, since most of those
+// checks are invalidated by eliminating earlier candidates or are not used
+// because a gate is found.  Valid checks of previous batches are kept
+// unless there are too many.
+
+void Internal::elim_check_candidates (Eliminator & eliminator, int idx) {
+  const unsigned n = min ((unsigned) opts.elimthreads, workers.size ());
+  assert (n > 1);
+  vector<ElimCheck> & checks = eliminator.checks;
+  vector<unsigned> & checked = eliminator.checked;
+  if (eliminator.fixed != stats.all.fixed || checks.size () > 16 * n)
+    elim_reset_checks (eliminator);
+  size_t kept = 0;
+  for (const auto & check : checks) {
+    const int other = abs (check.pivot);
+    if (!checked[other]) continue;
+    if (check.valid) checks[kept++] = check, checked[other] = kept;
+    else checked[other] = 0;
+  }
+  checks.resize (kept);
+  assert (!checked[idx]);
+  const ElimCheck first = { idx, false, false, 0 };
+  checks.push_back (first);
+  checked[idx] = checks.size ();
+  // The heap array of the schedule is not in the order in which candidates
+  // are popped.  Thus the next candidates are found by a best-first search
+  // from the root of the heap over the positions in its array, where the
+  // children of position 'i' are at '2i+1' and '2i+2'.
+  //
+  const ElimSchedule & schedule = eliminator.schedule;
+  const auto array = schedule.begin ();
+  const size_t size = schedule.size ();
+  elim_more more (this);
+  auto less = [&] (size_t i, size_t j) { return more (array[i], array[j]); };
+  vector<size_t> & front = eliminator.front;
+  front.clear ();
+  if (size) front.push_back (0);
+  while (!front.empty () && checks.size () - kept < n) {
+    pop_heap (front.begin (), front.end (), less);
+    const size_t i = front.back ();
+    front.pop_back ();
+    for (size_t j = 2*i + 1; j <= 2*i + 2 && j < size; j++) {
+      front.push_back (j);
+      push_heap (front.begin (), front.end (), less);
+    }
+    const unsigned other = array[i];
+    if (checked[other]) continue;
+    const ElimCheck check = { (int) other, false, false, 0 };
+    checks.push_back (check);
+    checked[other] = checks.size ();
+  }
+  eliminator.fixed = stats.all.fixed;
+  eliminator.marks.resize (n);
+  stats.elimchecks += checks.size () - kept;
+  workers.run (n, [this, n, kept, &eliminator] (unsigned worker) {
+    vector<signed char> & marks = eliminator.marks[worker];
+    if (marks.size () <= (size_t) max_var) marks.resize (max_var + 1);
+    vector<ElimCheck> & checks = eliminator.checks;
+    for (size_t i = kept + worker; i < checks.size (); i += n)
+      checks[i].valid = elim_check_resolvents (checks[i], marks);
+  });
+}
+
+// Use the result of checking 'pivot' in parallel if still valid.
+
+bool Internal::elim_checked_resolvents (Eliminator & eliminator,
+                                        int pivot, bool & bounded) {
+  if (eliminator.checked.empty ()) return false;
+  unsigned & pos = eliminator.checked[abs (pivot)];
+  if (!pos) return false;
+  const ElimCheck & check = eliminator.checks[pos - 1];
+  pos = 0;
+  if (!check.valid) return false;
+  if (eliminator.fixed != stats.all.fixed) return false;
+  assert (check.pivot == pivot);
+  stats.elimres += check.resolutions;
+  stats.elimrestried += check.resolutions;
+  stats.elimchecked++;
+  bounded = check.bounded;
+  LOG ("using parallel check of %" PRId64 " resolutions on %d",
+    check.resolutions, pivot);
+  return true;
+}
+
 /*------------------------------------------------------------------------*/
 // Add all resolvents on 'pivot' and connect them.
 
@@ -723,6 +919,13 @@ int Internal::elim_round (bool & completed) {
   //
   const int64_t garbage_limit = (2*stats.irrbytes/3) + (1<<20);
 
+  // With several threads the number of resolvents of the next candidates
+  // are checked in parallel (see 'elim_check_candidates' above).
+  //
+  workers.reserve (opts.elimthreads);
+  const bool checking = opts.elimthreads > 1 && workers.size () > 1;
+  if (checking) eliminator.checked.resize (max_var + 1);
+
   // Main loops tries to eliminate variables according to the schedule. The
   // schedule is updated dynamically and variables are potentially
   // rescheduled to be tried again if they occur in a removed clause.
@@ -737,6 +940,8 @@ int Internal::elim_round (bool & completed) {
     int idx = schedule.front ();
     schedule.pop_front ();
     flags (idx).elim = false;
+    if (checking && !eliminator.checked[idx])
+      elim_check_candidates (eliminator, idx);
     try_to_eliminate_variable (eliminator, idx);
 #ifndef QUIET
     tried++;
@@ -744,6 +949,7 @@ int Internal::elim_round (bool & completed) {
     if (stats.garbage <= garbage_limit) continue;
     mark_redundant_clauses_with_eliminated_variables_as_garbage ();
     garbage_collection ();
+    if (checking) elim_reset_checks (eliminator);
   }
 
   // If the schedule is empty all variables have been tried (even
@@ -839,7 +1045,7 @@ void Internal::elim (bool update_limits) {
 
   if (unsat) return;
   if (level) backtrack ();
-  if (!propagate ()) { learn_empty_clause (); return; }
+  if (!propagate ()) { build_chain (); learn_empty_clause (); return; }
 
   stats.elimphases++;
   PHASE ("elim-phase", stats.elimphases,
@@ -857,6 +1063,10 @@ void Internal::elim (bool update_limits) {
   if (last.elim.subsumephases == stats.subsumephases)
     subsume (update_limits);
 
+  // All the procedures below work on occurrence lists of clauses, which
+  // thus need to include binary clauses.
+  //
+  make_binaries_explicit ();
   reset_watches ();             // saves lots of memory
 
   // Alternate one round of bounded variable elimination ('elim_round') and
@@ -933,6 +1143,7 @@ void Internal::elim (bool update_limits) {
   }
 
   init_watches ();
+  make_binaries_implicit ();
   connect_watches ();
 
   if (unsat) LOG ("elimination derived empty clause");
@@ -941,6 +1152,7 @@ void Internal::elim (bool update_limits) {
       (size_t)(trail.size () - propagated));
     if (!propagate ()) {
       LOG ("propagating units after elimination results in empty clause");
+      build_chain ();
       learn_empty_clause ();
     }
   }
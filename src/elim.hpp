@@ -15,12 +15,24 @@ struct elim_more {
 
 typedef heap<elim_more> ElimSchedule;
 
+// Result of checking an elimination candidate in parallel with other
+// candidates (see 'elim_check_candidates' in 'elim.cpp').  It is only used
+// if no clause with the candidate variable changed in the mean time.
+
+struct ElimCheck {
+  int pivot;            // negated if it occurs more often positively
+  bool valid;           // no clause with 'pivot' changed since checked
+  bool bounded;         // result of 'elim_resolvents_are_bounded'
+  int64_t resolutions;  // number of resolved pairs of clauses
+};
+
 struct Eliminator {
 
   Internal * internal;
   ElimSchedule schedule;
 
-  Eliminator (Internal * i) : internal (i), schedule (elim_more (i)) { }
+  Eliminator (Internal * i) :
+    internal (i), schedule (elim_more (i)), fixed (0) { }
   ~Eliminator ();
 
   queue<Clause*> backward;
@@ -30,6 +42,12 @@ struct Eliminator {
 
   vector<Clause *> gates;
   vector<int> marked;
+
+  vector<ElimCheck> checks;     // candidates checked in parallel
+  vector<unsigned> checked;     // position in 'checks' plus one (or zero)
+  int64_t fixed;                // fixed variables when checked
+  vector<vector<signed char>> marks;    // per worker for checking
+  vector<size_t> front;         // schedule positions to check next
 };
 
 }
@@ -1,4 +1,5 @@
 #include "internal.hpp"
+#include "learnerobserver.hpp"
 
 namespace CaDiCaL {
 
@@ -11,6 +12,10 @@ External::External (Internal * i)
   terminator (0),
   learner (0),
   learnSource (0),
+  exporter (0),
+  export_batch (0),
+  export_buffered (0),
+  learner_observed (false),
   solution (0),
   vars (max_var)
 {
@@ -241,6 +246,7 @@ int External::solve (bool preprocess_only) {
   reset_extended ();
   update_molten_literals ();
   int res = internal->solve (preprocess_only);
+  if (exporter) flush_exported_clauses ();
   if (res == 10) extend ();
   else if (res == 20) internal->finalize ();
   check_solve_result (res);
@@ -514,7 +520,9 @@ void External::export_learned_empty_clause () {
 }
 
 void External::export_learned_unit_clause (clause_id_t clause_id, int elit) {
-  assert (learner);
+  internal->fingerprint_learned_clause (&elit, 1);
+  if (exporter) export_clause (clause_id, 1, &elit, 1);
+  if (!learner) return;
   //1 + 2:  1 literals + 2 metedata ints for clause ID
   if (learner->learning (1 + 2)) {
     LOG ("exporting learned unit clause");
@@ -534,9 +542,11 @@ void External::export_learned_unit_clause (clause_id_t clause_id, int elit) {
 }
 
 void External::export_learned_large_clause (clause_id_t clause_id, const vector<int> & clause, int glue) {
-  assert (learner);
   size_t size = clause.size ();
   assert (size <= (unsigned) INT_MAX);
+  internal->fingerprint_learned_clause (clause.data (), (int) size);
+  if (exporter) export_clause (clause_id, glue, clause.data (), (int) size);
+  if (!learner) return;
   //size + 2:  size literals + 2 metadata ints for clause ID
   if (learner->learning ((int) size + 2)) {
     LOG ("exporting learned clause of size %zu", size);
@@ -559,4 +569,89 @@ void External::export_learned_large_clause (clause_id_t clause_id, const vector<
     LOG ("not exporting learned clause of size %zu", size);
 }
 
+/*------------------------------------------------------------------------*/
+
+// Exporting a whole clause with one virtual call instead of one call per
+// literal.  In batched mode the clause is appended as packed record to the
+// export buffer instead, which is handed over to the exporter as soon
+// 'export_batch' clauses are collected.
+
+void External::export_clause (clause_id_t clause_id, int glue,
+                              const int * elits, int size) {
+  assert (exporter);
+  assert (size > 0);
+  if (!exporter->exporting (size, glue)) {
+    LOG ("not exporting learned clause of size %d", size);
+    return;
+  }
+  if (export_batch <= 1) {
+    LOG ("exporting learned clause of size %d", size);
+    exporter->export_clause (clause_id, glue, elits, size);
+    return;
+  }
+  LOG ("buffering learned clause of size %d for export", size);
+  uint64_t u_clause_id = (uint64_t) clause_id;
+  int clause_id_ints[2];
+  memcpy (clause_id_ints, &u_clause_id, sizeof (uint64_t));
+  if (size == 1) export_buffer.push_back (3);
+  else {
+    export_buffer.push_back (size + 3);
+    export_buffer.push_back (glue);
+  }
+  export_buffer.push_back (clause_id_ints[0]);
+  export_buffer.push_back (clause_id_ints[1]);
+  export_buffer.insert (export_buffer.end (), elits, elits + size);
+  if (++export_buffered >= export_batch) flush_exported_clauses ();
+}
+
+void External::flush_exported_clauses () {
+  assert (exporter);
+  if (!export_buffered) return;
+  LOG ("flushing %d buffered exported clauses", export_buffered);
+  exporter->export_clauses (export_buffer.data (), export_buffer.size (),
+                            export_buffered);
+  export_buffer.clear ();
+  export_buffered = 0;
+}
+
+// Connect the proof observer which feeds both 'learner' and 'exporter'.
+// Exporting whole clauses should work without tracing or checking a proof
+// and thus we enable the proof object on demand for the exporter.
+
+void External::connect_learner_observer () {
+  if (learner_observed) return;
+  if (!internal->proof) {
+    if (!exporter) return;
+    internal->new_proof_on_demand ();
+  }
+  internal->proof->connect (new LearnerObserver (this));
+  learner_observed = true;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Default implementation of batched export which decodes the packed
+// records and exports them one by one.
+
+void ClauseExporter::export_clauses (const int * records, size_t size,
+                                     int clauses) {
+  const int * p = records, * end = records + size;
+  while (p != end) {
+    assert (p < end);
+    const int n = *p++;
+    int64_t id;
+    if (n == 3) {
+      memcpy (&id, p, sizeof id);
+      export_clause (id, 1, p + 2, 1);
+    } else {
+      assert (n >= 5);
+      memcpy (&id, p + 1, sizeof id);
+      export_clause (id, p[0], p + 3, n - 3);
+    }
+    p += n;
+    clauses--;
+  }
+  assert (!clauses);
+}
+
 }
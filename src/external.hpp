@@ -88,11 +88,29 @@ struct External {
   Learner * learner;
   LearnSource * learnSource;
 
+  // Exporting whole clauses through 'ClauseExporter' optionally buffers
+  // 'export_batch' clauses as packed records in 'export_buffer'.
+
+  ClauseExporter * exporter;
+  int export_batch;           // Flush after that many buffered clauses.
+  int export_buffered;        // Number of clauses in 'export_buffer'.
+  vector<int> export_buffer;  // Packed records (see 'cadical.hpp').
+
+  // Both 'learner' and 'exporter' are fed by the same proof observer,
+  // which is only connected once.
+
+  bool learner_observed;
+  void connect_learner_observer ();
+
   void export_learned_empty_clause ();
   //assume literals are already externalized for both of these
   void export_learned_unit_clause (clause_id_t clause_id, int elit);
   void export_learned_large_clause (clause_id_t clause_id, const vector<int> &, int glue);
 
+  void export_clause (clause_id_t clause_id, int glue,
+                      const int * elits, int size);
+  void flush_exported_clauses ();
+
   //----------------------------------------------------------------------//
 
   signed char * solution;     // Given solution checking for debugging.
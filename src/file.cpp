@@ -203,6 +203,31 @@ FILE * File::write_pipe (Internal * internal,
   return open_pipe (internal, fmt, path, "w");
 }
 
+// Decompress in-process if supported and otherwise through a pipe.
+
+FILE * File::read_codec (Internal * internal,
+                         const char * fmt, const int * sig,
+                         const char * path, int & close_input) {
+  if (!decompressible (path))
+    return read_pipe (internal, fmt, sig, path);
+  if (!File::exists (path)) return 0;
+  if (sig && !File::match (internal, path, sig)) return 0;
+  FILE * res = decompress (path);
+  if (!res) return 0;
+  MSG ("decompressing '%s' in-process", path);
+  close_input = 3;
+  return res;
+}
+
+FILE * File::write_codec (Internal * internal, const char * path) {
+  FILE * res = compress (path);
+  if (res) MSG ("compressing '%s' in-process", path);
+#ifdef QUIET
+  (void) internal;
+#endif
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 File * File::read (Internal * internal, FILE * f, const char * n) {
@@ -217,16 +242,17 @@ File * File::read (Internal * internal, const char * path) {
   FILE * file;
   int close_input = 2;
   if (has_suffix (path, ".xz")) {
-    file = read_pipe (internal, "xz -c -d %s", xzsig, path);
+    file = read_codec (internal, "xz -c -d %s", xzsig, path, close_input);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".lzma")) {
-    file = read_pipe (internal, "lzma -c -d %s", lzmasig, path);
+    file = read_codec (internal,
+                       "lzma -c -d %s", lzmasig, path, close_input);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".bz2")) {
     file = read_pipe (internal, "bzip2 -c -d %s", bz2sig, path);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".gz")) {
-    file = read_pipe (internal, "gzip -c -d %s", gzsig, path);
+    file = read_codec (internal, "gzip -c -d %s", gzsig, path, close_input);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".7z")) {
     file = read_pipe (internal, "7z x -so %s 2>/dev/null", sig7z, path);
@@ -243,7 +269,9 @@ READ_FILE:
 File * File::write (Internal * internal, const char * path) {
   FILE * file;
   int close_input = 2;
-  if (has_suffix (path, ".xz"))
+  if ((file = write_codec (internal, path)))
+    close_input = 3;
+  else if (has_suffix (path, ".xz"))
     file = write_pipe (internal, "xz -c > %s", path);
   else if (has_suffix (path, ".bz2"))
     file = write_pipe (internal, "bzip2 -c > %s", path);
@@ -271,6 +299,10 @@ void File::close () {
     MSG ("closing pipe command on '%s'", name ());
     pclose (file);
   }
+  if (close_file == 3) {
+    MSG ("closing compressed file '%s'", name ());
+    fclose (file);
+  }
 
   file = 0;     // mark as closed
 
@@ -281,7 +313,7 @@ void File::close () {
     MSG ("after writing %" PRIu64 " bytes %.1f MB", bytes (), mb);
   else
     MSG ("after reading %" PRIu64 " bytes %.1f MB", bytes (), mb);
-  if (close_file == 2) {
+  if (close_file >= 2) {
     int64_t s = size (name ());
     double mb = s / (double) (1<<20);
     if (writing)
@@ -296,9 +328,9 @@ void File::close () {
 #endif
 }
 
-void File::flush () {
+bool File::flush () {
   assert (file);
-  fflush (file);
+  return !fflush (file);
 }
 
 File::~File () { if (file) close (); }
@@ -24,7 +24,9 @@ namespace CaDiCaL {
 // Wraps a 'C' file 'FILE' with name and supports zipped reading and writing
 // through 'popen' using external helper tools.  Reading has line numbers.
 // Compression and decompression relies on external utilities, e.g., 'gzip',
-// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.
+// 'bzip2', 'xz', and '7z', which should be in the 'PATH', unless 'zlib' or
+// 'liblzma' are configured to handle '.gz' respectively '.xz' and '.lzma'
+// files in-process (see 'codec.cpp').
 
 struct Internal;
 
@@ -37,7 +39,7 @@ class File {
   bool writing;
 #endif
 
-  int close_file;       // need to close file (1=fclose, 2=pclose)
+  int close_file;       // need to close file (1=fclose, 2=pclose, 3=codec)
   FILE * file;
   const char * _name;
   uint64_t _lineno;
@@ -60,6 +62,12 @@ class File {
                            const char * path);
   static FILE * write_pipe (Internal *,
                             const char * fmt, const char * path);
+  static FILE * read_codec (Internal *,
+                            const char * fmt,
+                            const int * sig,
+                            const char * path,
+                            int & close_input);
+  static FILE * write_codec (Internal *, const char * path);
 public:
 
   static char* find (const char * prg);    // search in 'PATH'
@@ -67,6 +75,14 @@ public:
   static bool writable (const char * path);// can write to that file?
   static size_t size (const char * path);  // file size in bytes
 
+  // In-process decompression and compression based on the suffix of the
+  // path.  Returns zero if this compression format is not supported
+  // in-process (or opening failed).  The result is closed with 'fclose'.
+  //
+  static bool decompressible (const char * path);
+  static FILE * decompress (const char * path);
+  static FILE * compress (const char * path);
+
   // Does the file match the file type signature.
   //
   static bool match (Internal *, const char * path, const int * sig);
@@ -163,13 +179,20 @@ public:
     }
   }
 
+  bool write (const char * data, size_t size) {
+    assert (writing);
+    if (fwrite (data, 1, size, file) != size) return false;
+    _bytes += size;
+    return true;
+  }
+
   const char * name () const { return _name; }
   uint64_t lineno () const { return _lineno; }
   uint64_t bytes () const { return _bytes; }
 
   bool closed () { return !file; }
   void close ();
-  void flush ();
+  bool flush ();
 };
 
 }
@@ -47,6 +47,47 @@ Internal::second_literal_in_binary_clause (Eliminator & eliminator,
 
 /*------------------------------------------------------------------------*/
 
+// For the LRAT chain of a hyper unary resolvent we need to find the actual
+// binary clause with 'first' and 'second' again, since we only mark the
+// second literal.  This is rare and thus the search is acceptable.
+
+Clause * Internal::find_binary_clause_in_occs (int first, int second) {
+  for (const auto & c : occs (first)) {
+    if (c->garbage) continue;
+    bool found = false, binary = true;
+    for (const auto & lit : *c) {
+      if (lit == first) continue;
+      if (lit == second) { found = true; continue; }
+      if (val (lit) >= 0) { binary = false; break; }
+    }
+    if (found && binary) return c;
+  }
+  return 0;
+}
+
+// Add the LRAT chain for the hyper unary resolvent 'first' of the clauses
+// 'c' and 'd', which apart from 'first' and the clashing pivot only contain
+// root level falsified literals, e.g., actual binary clauses 'first' and
+// 'second' respectively 'first' and '-second'.  Literals falsified in both
+// need only one unit.  We can not use marks here, since those of
+// 'mark_binary_literals' are still in use.
+
+void Internal::build_hyper_unary_chain (Clause * c, Clause * d, int first) {
+  if (!proof || !opts.lrat) return;
+  assert (c), assert (d);
+  for (const auto & lit : *c)
+    if (lit != first && val (lit) < 0)
+      chain.push_back (var (lit).unit_id);
+  for (const auto & lit : *d)
+    if (lit != first && val (lit) < 0 &&
+        find (c->begin (), c->end (), lit) == c->end ())
+      chain.push_back (var (lit).unit_id);
+  chain.push_back (c->id);
+  chain.push_back (d->id);
+}
+
+/*------------------------------------------------------------------------*/
+
 // Mark all other literals in binary clauses with 'first'.  During this
 // marking we might also detect hyper unary resolvents producing a unit.
 // If such a unit is found we propagate it and return immediately.
@@ -69,7 +110,9 @@ void Internal::mark_binary_literals (Eliminator & eliminator, int first) {
     const int tmp = marked (second);
     if (tmp < 0) {
       LOG ("found binary resolved unit %d", first);
-      PROOF_TODO (proof, "mark binary literals unit", 60); // TODO(Mario)
+      if (proof && opts.lrat)
+        build_hyper_unary_chain (c,
+          find_binary_clause_in_occs (first, -second), first);
       assign_unit (first);
       elim_propagate (eliminator, first);
       return;
@@ -124,7 +167,9 @@ void Internal::find_equivalence (Eliminator & eliminator, int pivot) {
     const int tmp = marked (second);
     if (tmp > 0) {
       LOG ("found binary resolved unit %d", second);
-      PROOF_TODO (proof, "find equivalence unit", 61); // TODO(Mario)
+      if (proof && opts.lrat)
+        build_hyper_unary_chain (c,
+          find_binary_clause_in_occs (pivot, second), second);
       assign_unit (second);
       elim_propagate (eliminator, second);
       if (val (pivot)) break;
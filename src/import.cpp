@@ -0,0 +1,474 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Importing redundant clauses learned by other solver instances through
+// the connected 'LearnSource'.  Received clauses pass an import policy
+// stage first.  Clauses with too large glue ('importglue') or too many
+// literals ('importsize') are rejected.  If further the number of imported
+// clauses per round is limited ('importlim') then received clauses are
+// queued and the ones with the smallest glue and size are imported first,
+// while the others are deferred to later import rounds.  The queue is
+// bounded ('importqueue') by dropping the worst candidates.  Since queued
+// clauses keep their clause id, deferring does not affect proofs.
+
+bool Internal::importing () {
+  if (level && !opts.importlevels) return false;
+  if (!external->learnSource) return false;
+  if (!watching ()) return false;
+  if (opts.importlim && stats.import.rounds &&
+      stats.conflicts == last.import.conflicts) return false;
+  if (!import_queue.empty ()) return true;
+  return external->learnSource->hasNextClause ();
+}
+
+/*------------------------------------------------------------------------*/
+
+//Check whether we can add an imported clause to our set of clauses
+const int SINGLETON_CLAUSE_SIZE = 3;
+const int NON_SINGLETON_MIN_CLAUSE_SIZE = 5;
+
+
+Internal::IMPORT_TYPE Internal::create_internal_clause(const int * cls,
+  size_t size, clause_id_t &clause_id, int &glue) {
+
+    //if there are falsified literals in the imported clause, we need
+    //   to create a new, simplified clause to add in its place
+    bool need_to_simplify = false;
+    chain.clear();
+
+    // clause is either a singleton or has at least two elements.
+    assert (size == SINGLETON_CLAUSE_SIZE || 
+            size >= NON_SINGLETON_MIN_CLAUSE_SIZE);
+    
+    size_t i; 
+
+    // determine clause header information from imported clause
+    if (size == SINGLETON_CLAUSE_SIZE) {
+        memcpy(&clause_id, cls, sizeof(clause_id_t));
+        // skip the clause id.  Glue is 1 for unit.
+        glue = 1;
+        i = 2;
+    } else {
+        memcpy(&clause_id, cls + 1, sizeof(clause_id_t));
+        glue = cls[2];
+        i = 3;
+    }
+    
+    // determine clause body from imported clause, and whether to import it.
+    while (i < size){
+        int elit = cls[i];
+        assert (elit != 0);
+
+        if (external->marked (external->witness, elit)) {
+            // Literal marked as witness: Cannot import
+            return Internal::IMPORT_TYPE::NO_IMPORT;
+        }
+
+        //The only side effects of this are to increase the mapping between internal and external.
+        //Therefore it doesn't matter if we internalize something that isn't going to be imported.
+        int ilit = external->internalize(elit);
+
+        auto& f = flags (ilit);
+        if (f.eliminated () || f.substituted ()) {
+            // Literal has been eliminated or substituted: do not add this clause.
+             return Internal::IMPORT_TYPE::NO_IMPORT;
+        }
+        else if (f.fixed ()){
+            if (val (ilit) == 1) {
+                //fixed and true:  clause is already satisfied, and can be omitted
+              return Internal::IMPORT_TYPE::NO_IMPORT;
+            }
+            else{
+                //clause is false and we need to simplify the clause to import it
+                need_to_simplify = true;
+                // Unit ids are only maintained with proofs.
+                if (proof) {
+                  int eidx = elit < 0 ? -elit : elit;
+                  chain.push_back(external->unit_id[eidx]);
+                }
+            }
+        } else{
+            //only include non-fixed literals in the clause
+            // MWW change: need to push back the **INTERNAL** literals
+            // not the **EXTERNAL** literals. 
+            // 
+            // Produced clause should be an internal clause.
+            //
+            clause.push_back(ilit);
+        }
+        i++;
+    }
+    if (need_to_simplify){
+        return Internal::IMPORT_TYPE::SIMPLIFIED_IMPORT;
+    }
+    return Internal::IMPORT_TYPE::DIRECT_IMPORT;
+}
+
+
+/*------------------------------------------------------------------------*/
+
+// Determine glue and size of a received clause record.  See 'cadical.hpp'
+// for the format of these records.
+
+inline static void
+import_glue_and_size (const int * cls, size_t n, int & glue, int & size) {
+  if (n == 3) glue = size = 1;
+  else {
+    assert (n >= 5);
+    glue = cls[0];
+    size = (int) n - 3;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+ClauseFingerprints::ClauseFingerprints () {
+  Random random (42);
+  for (unsigned n = 0; n < num_nonces; n++) {
+    uint64_t nonce = random.next ();
+    if (!(nonce & 1)) nonce++;
+    assert (nonce), assert (nonce & 1);
+    nonces[n] = nonce;
+  }
+}
+
+void ClauseFingerprints::resize (unsigned bits) {
+  assert (bits < 8 * sizeof (size_t));
+  erase ();
+  if (bits) table.resize ((size_t) 1 << bits, 0);
+}
+
+// Literals are hashed individually and then added up, which makes the
+// fingerprint independent of the order of the literals.
+
+uint64_t ClauseFingerprints::compute (const int * lits, int size) const {
+  uint64_t res = nonces[0] * (uint64_t) size;
+  for (int i = 0; i < size; i++) {
+    uint64_t tmp = nonces[1] * (uint64_t) (unsigned) lits[i];
+    tmp ^= tmp >> 32;
+    tmp *= nonces[2];
+    tmp ^= tmp >> 29;
+    res += tmp;
+  }
+  res *= nonces[3];
+  res ^= res >> 32;
+  return res ? res : 1;
+}
+
+// Fingerprints are only needed if clauses are actually imported.  The
+// table is (re)allocated lazily here whenever 'importhash' changed.
+
+bool Internal::fingerprinting () {
+  if (!opts.importhash) {
+    if (fingerprints.enabled ()) fingerprints.erase ();
+    return false;
+  }
+  if (!external->learnSource) return false;
+  const size_t size = (size_t) 1 << opts.importhash;
+  if (fingerprints.size () != size) fingerprints.resize (opts.importhash);
+  return true;
+}
+
+// Called for learned clauses which are exported (in external literals).
+
+void Internal::fingerprint_learned_clause (const int * lits, int size) {
+  if (!fingerprinting ()) return;
+  fingerprints.insert (fingerprints.compute (lits, size));
+  stats.import.hashed++;
+}
+
+// Check whether the received clause was recently imported, learned or
+// received (and is still queued) and otherwise remember it.
+
+bool Internal::import_duplicated (const int * cls, size_t n) {
+  if (!fingerprinting ()) return false;
+  const int * lits;
+  int size;
+  if (n == 3) lits = cls + 2, size = 1;
+  else lits = cls + 3, size = (int) n - 3;
+  const uint64_t fingerprint = fingerprints.compute (lits, size);
+  if (fingerprints.contains (fingerprint)) return true;
+  fingerprints.insert (fingerprint);
+  stats.import.hashed++;
+  return false;
+}
+
+bool Internal::import_rejected (int glue, int size) {
+  if (opts.importglue && glue > opts.importglue) return true;
+  if (opts.importsize && size > opts.importsize) return true;
+  return false;
+}
+
+// Received clauses are either imported right away or queued.
+
+void Internal::receive_redundant_clause (const int * cls, size_t n,
+                                         int& res) {
+  stats.import.received++;
+  int glue, size;
+  import_glue_and_size (cls, n, glue, size);
+  if (import_rejected (glue, size)) {
+    LOG ("rejecting import of clause of size %d with glue %d", size, glue);
+    stats.import.rejected++;
+  } else if (import_duplicated (cls, n)) {
+    LOG ("dropping duplicated import of clause of size %d", size);
+    stats.import.duplicated++;
+  } else if (opts.importlim) {
+    ImportCandidate candidate;
+    candidate.pos = import_queue.records.size ();
+    candidate.glue = glue;
+    candidate.size = size;
+    import_queue.candidates.push_back (candidate);
+    import_queue.records.push_back ((int) n);
+    import_queue.records.insert (import_queue.records.end (), cls, cls + n);
+  } else import_redundant_clause (cls, n, res);
+}
+
+// Clauses are either handed over one by one through 'getNextClause' or
+// (if the learn source supports it) as whole buffers of packed clause
+// records through 'getNextClauses'.  The latter are walked in place
+// without copying individual clauses (unless they are queued).
+
+void Internal::import_redundant_clauses (int& res) {
+  LearnSource * source = external->learnSource;
+  if (source == 0) return;
+  if (res != 0) return;
+
+  stats.import.rounds++;
+  last.import.conflicts = stats.conflicts;
+
+  // Receive external clauses.
+  for (;;) {
+    size_t size;
+    const int * records = source->getNextClauses (size);
+    if (records) {
+      const int * p = records, * end = records + size;
+      while (!res && p != end) {
+        assert (p < end);
+        const int n = *p++;
+        receive_redundant_clause (p, n, res);
+        p += n;
+      }
+    } else if (source->hasNextClause ()) {
+      // Fetch a reference to the clause (plus glue and id) without copying.
+      const vector<int> & cls = source->getNextClause ();
+      receive_redundant_clause (cls.data (), cls.size (), res);
+    } else break;
+    if (res) break;
+  }
+
+  if (!res && !import_queue.empty ()) import_queued_clauses (res);
+}
+
+// Import the best 'importlim' queued clauses, keep the next 'importqueue'
+// ones for the next round and drop the rest.  The remaining records are
+// copied in priority order, which keeps them ordered by arrival among
+// candidates with the same glue and size in later rounds too.
+
+void Internal::import_queued_clauses (int& res) {
+  assert (opts.importlim);
+  vector<ImportCandidate> & candidates = import_queue.candidates;
+  vector<int> & records = import_queue.records;
+  sort (candidates.begin (), candidates.end (), import_candidate_less ());
+  const size_t size = candidates.size ();
+  const size_t imported = min (size, (size_t) opts.importlim);
+  LOG ("importing %zd out of %zd queued clauses", imported, size);
+  size_t i = 0;
+  while (!res && i < imported) {
+    const size_t pos = candidates[i++].pos;
+    import_redundant_clause (records.data () + pos + 1, records[pos], res);
+  }
+  if (res) {
+    import_queue.erase ();
+    return;
+  }
+  const size_t kept = min (size - i, (size_t) opts.importqueue);
+  stats.import.deferred += kept;
+  stats.import.dropped += size - i - kept;
+  vector<int> remaining;
+  size_t j = 0;
+  while (j < kept) {
+    ImportCandidate & c = candidates[i++];
+    const int * r = records.data () + c.pos;
+    c.pos = remaining.size ();
+    remaining.insert (remaining.end (), r, r + r[0] + 1);
+    candidates[j++] = c;
+  }
+  candidates.resize (j);
+  records.swap (remaining);
+}
+
+void Internal::import_redundant_clause (const int * cls, size_t cls_size,
+                                        int& res) {
+  assert (clause.empty ());
+
+  // create_internal_clause overwrites the internal 'clause' member 
+  // that is the placeholder `builder' clause.  Depending on the 
+  // structure of the literals in the external clause, we may decide to 
+  // skip the clause (return NO_IMPORT), directly import the 
+  // clause (return DIRECT_IMPORT), or simplify the clause prior
+  // to importing it (return SIMPLIFIED_IMPORT).
+  int glue;
+  clause_id_t clause_id; 
+  Clause * searching = 0;
+  Internal::IMPORT_TYPE importType = 
+    create_internal_clause(cls, cls_size, clause_id, glue);
+
+  if (importType == Internal::IMPORT_TYPE::NO_IMPORT) {
+    stats.import.skipped++;
+  } else {
+    stats.import.imported++;
+    // import clause.
+    // First, if we simplify the clause, then the clause is a new
+    // clause, so for the proof we want to derive it from the 
+    // imported clause.  This causes us to give the clause 
+    // a new clause id and glue value. 
+    // 
+    // Then we do different things depending on whether the clause 
+    // after possible simplification contains no literals 
+    // (in which case we are done), one literal (in which case
+    // we import unit), or more than one literal (in which case 
+    // we import a `normal' clause).  We have to track whether 
+    // the clause is a direct import to determine how to represent
+    // it in the proof.  For a direct import, the "reason" comes
+    // from another proof, so we need to track that the clause is 
+    // remote.
+    // For a simplified input clause, the "reason" involves local 
+    // clauses and also the clause id of the remote clause.
+
+    bool is_direct_import; 
+    
+    chain.push_back(clause_id); // Add imported clause to proof of the simplified clause.
+    if (importType == Internal::IMPORT_TYPE::DIRECT_IMPORT) {
+      // use glue and clause_id from the create_clause_id function.
+      is_direct_import = true;
+    } else if (importType == Internal::IMPORT_TYPE::SIMPLIFIED_IMPORT) { // Simplified
+      // Since this is a 'new' clause, we don't have a glue computed, so use the size
+      glue = clause.size();
+      clause_id = next_clause_id();
+      is_direct_import = false;
+    } else {
+      is_direct_import = false;
+      assert(false && "Missing case in import_redundant_clauses function");
+    }
+
+    size_t size = clause.size();
+    if (size == 0){
+        unsat = true;
+        if (proof) proof->add_derived_empty_clause(clause_id);
+    }
+    else if (size == 1){
+        // Units are always assigned on the root-level.
+        if (level) backtrack ();
+        // why do we do both of these?  Ah, one is for the proof, and one is for 
+        // use in solving.
+        if (proof) proof->add_derived_unit_clause(clause_id, clause[0], is_direct_import);          
+        // Without proof the chain is not consumed but 'build_chain' in
+        // 'assign_original_unit' expects it to be empty.
+        chain.clear();
+        // MWW 9/13/2022: need to add the clause to the chain, in case we derive the empty clause
+        // in assign_original_unit.
+        // Dominik Schreiber 2022-10-05: Store ID in a separate temporary variable
+        // such that it won't be overwritten by intermediate propagation.
+        // TODO Replace with something more robust.
+        assign_original_unit(clause_id, clause[0]);
+    }
+    else if (size == 2){
+        external->check_learned_clause ();
+        new_binary_clause (clause_id, true);
+        if (proof) proof->add_derived_binary_clause (clause_id, clause[0], clause[1], is_direct_import);
+        if (level) searching = binary_clause (&binary_conflict_clause, clause[0], clause[1], clause_id, true);
+    }
+    else{
+        external->check_learned_clause ();
+        Clause *new_built_clause = new_clause(clause_id, true, glue);
+        if (proof) proof->add_derived_clause(new_built_clause, is_direct_import);
+        assert (watching());
+        if (level) searching = new_built_clause;
+        else watch_clause (new_built_clause);
+    }
+  }
+  //we can't need these anymore, so clear them
+  clause.clear();
+  chain.clear();
+
+  // Clauses imported during search are watched and possibly propagated or
+  // analyzed after the builder clause and the chain are not needed anymore.
+  if (searching) watch_imported_clause (searching);
+
+  // Stop importing if SAT or UNSAT was found
+  if (unsat) {
+    res = 20;
+    return;
+  }
+  if (satisfied ()) {
+    res = 10;
+    return;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Clauses can be imported at non-zero decision levels too, which lets them
+// take effect before the next restart.  Then the two literals to watch
+// have to be chosen with respect to the current assignment.  Non-false
+// literals are preferred (true before unassigned) and otherwise literals
+// with higher assignment level.  Literals assigned on the root-level have
+// already been removed in 'create_internal_clause'.
+
+inline bool Internal::better_imported_watch (int a, int b) {
+  const signed char u = val (a), v = val (b);
+  if (u < 0 && v < 0) return var (a).level > var (b).level;
+  if (u < 0 || v < 0) return v < 0;
+  if (u > 0 && v > 0) return var (a).level < var (b).level;
+  return u > v;
+}
+
+// If the resulting clause is unit under the current assignment we
+// backtrack to the level of the second watch and assign the first.  If it
+// is falsified and has two literals on the highest level then we
+// backtrack to that level and analyze it as conflict.  If the first
+// watch is true on a higher level than the (false) second watch we miss
+// an earlier implication, which is harmless.  Imported binary clauses are
+// already added to the binary watches and passed as temporary binary
+// conflict clause.
+
+void Internal::watch_imported_clause (Clause * c) {
+  assert (level);
+  assert (!conflict);
+  assert (clause.empty ()), assert (chain.empty ());
+  const bool binary = (c == &binary_conflict_clause);
+  int * lits = c->literals;
+  const int size = c->size;
+  for (int i = 0; i < 2; i++)
+    for (int j = i + 1; j < size; j++)
+      if (better_imported_watch (lits[j], lits[i]))
+        swap (lits[i], lits[j]);
+  if (!binary) watch_clause (c);
+  const int lit = lits[0], other = lits[1];
+  if (val (other) >= 0) return;
+  if (val (lit) > 0) return;
+  const int other_level = var (other).level;
+  assert (other_level > 0);
+  if (!val (lit) || var (lit).level > other_level) {
+    LOG (c, "imported clause propagates %d at level %d", lit, other_level);
+    stats.import.propagating++;
+    backtrack (other_level);
+    if (binary) search_assign_driving (lit, binary_reason (other), c->id);
+    else search_assign_driving (lit, c);
+  } else {
+    assert (var (lit).level == other_level);
+    LOG (c, "imported clause conflicting at level %d", other_level);
+    stats.import.conflicting++;
+    backtrack (other_level);
+    if (stable) stats.stabconflicts++;
+    stats.conflicts++;
+    conflict = c;
+    analyze ();
+  }
+  while (!unsat && !propagate ()) analyze ();
+}
+
+}
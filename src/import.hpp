@@ -0,0 +1,91 @@
+#ifndef _import_hpp_INCLUDED
+#define _import_hpp_INCLUDED
+
+#include "util.hpp"     // Alphabetically after 'import'.
+
+namespace CaDiCaL {
+
+// If the number of clauses imported per round is limited ('importlim')
+// then received clauses are first copied as packed records (see
+// 'cadical.hpp') to 'records' and then the best candidates in terms of
+// glue and size are imported while the rest stays queued for later rounds.
+
+struct ImportCandidate {
+  size_t pos;           // position of record in 'ImportQueue::records'
+  int glue;             // glue as exported (one for units)
+  int size;             // number of literals
+};
+
+// Smaller glue first, then smaller size and otherwise received earlier.
+
+struct import_candidate_less {
+  bool operator () (const ImportCandidate & a,
+                    const ImportCandidate & b) const {
+    if (a.glue != b.glue) return a.glue < b.glue;
+    if (a.size != b.size) return a.size < b.size;
+    return a.pos < b.pos;
+  }
+};
+
+struct ImportQueue {
+  vector<int> records;
+  vector<ImportCandidate> candidates;
+
+  bool empty () const { return candidates.empty (); }
+
+  void erase () {
+    erase_vector (records);
+    erase_vector (candidates);
+  }
+};
+
+// Lossy table of fingerprints of recently imported and recently learned
+// (exported) clauses in terms of external literals, used to drop exact
+// duplicates at import time.  The fingerprint is a commutative sum of
+// literal hashes, similar to the nonce based clause hashing in 'Checker'
+// but independent of the order of literals.  Each fingerprint has exactly
+// one slot in the table and newer fingerprints simply overwrite older ones.
+// Thus the table only remembers recent clauses and hash collisions can
+// make us drop a clause which was not seen before.  Both are fine since
+// imported clauses are redundant anyhow.
+
+class ClauseFingerprints {
+
+  static const unsigned num_nonces = 4;
+
+  uint64_t nonces[num_nonces];  // random numbers for hashing
+  vector<uint64_t> table;       // zero means empty slot
+
+  size_t slot (uint64_t fingerprint) const {
+    return (fingerprint ^ (fingerprint >> 32)) & (table.size () - 1);
+  }
+
+public:
+
+  ClauseFingerprints ();
+
+  // Resize (and clear) the table to '2^bits' entries ('0' disables).
+  //
+  void resize (unsigned bits);
+
+  bool enabled () const { return !table.empty (); }
+  size_t size () const { return table.size (); }
+
+  uint64_t compute (const int * lits, int size) const;
+
+  bool contains (uint64_t fingerprint) const {
+    assert (enabled ());
+    return table[slot (fingerprint)] == fingerprint;
+  }
+
+  void insert (uint64_t fingerprint) {
+    assert (enabled ());
+    table[slot (fingerprint)] = fingerprint;
+  }
+
+  void erase () { erase_vector (table); }
+};
+
+}
+
+#endif
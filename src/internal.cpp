@@ -13,10 +13,15 @@ Internal::Internal ()
   lookingahead (false),
   preprocessing (false),
   protected_reasons (false),
+  explicit_binaries (false),
+  watching_clauses (true),
   force_saved_phase (false),
   searching_lucky_phases (false),
   stable (false),
   reported (false),
+#ifdef SIMD
+  simd (simd_supported ()),
+#endif
   rephased (0),
   vsize (0),
   max_var (0),
@@ -24,6 +29,7 @@ Internal::Internal ()
   vals (0),
   score_inc (1.0),
   scores (this),
+  hyper_binaries (0),
   conflict (0),
   ignore (0),
   propagated (0),
@@ -48,7 +54,8 @@ Internal::Internal ()
   lits (this->max_var)
 {
   original_count = 0;
-  learned_count = 0;
+  init_clause_ids ();
+  init_binary_clauses ();
   control.push_back (Level (0, 0));
 }
 
@@ -83,7 +90,10 @@ static signed char * ignore_clang_analyze_memory_leak_warning;
 
 void Internal::enlarge_vals (size_t new_vsize) {
   signed char * new_vals;
-  const size_t bytes = 2u * new_vsize;
+  size_t bytes = 2u * new_vsize;
+#ifdef SIMD
+  bytes += sizeof (int);        // padding for gathers in 'simd.cpp'
+#endif
   new_vals = new signed char [ bytes ]; // g++-4.8 does not like ... { 0 };
   memset (new_vals, 0, bytes);
   ignore_clang_analyze_memory_leak_warning = new_vals;
@@ -226,193 +236,6 @@ int Internal::cdcl_loop_with_inprocessing () {
   return res;
 }
 
-bool Internal::importing () {
-  return level == 0 && external->learnSource != 0 
-      && watching() && external->learnSource->hasNextClause ();
-}
-
-//Check whether we can add an imported clause to our set of clauses
-const int SINGLETON_CLAUSE_SIZE = 3;
-const int NON_SINGLETON_MIN_CLAUSE_SIZE = 5;
-
-
-Internal::IMPORT_TYPE Internal::create_internal_clause(std::vector<int> cls, 
-  clause_id_t &clause_id, int &glue) {
-    size_t size = cls.size();
-
-    //if there are falsified literals in the imported clause, we need
-    //   to create a new, simplified clause to add in its place
-    bool need_to_simplify = false;
-    chain.clear();
-
-    // clause is either a singleton or has at least two elements.
-    assert (size == SINGLETON_CLAUSE_SIZE || 
-            size >= NON_SINGLETON_MIN_CLAUSE_SIZE);
-    
-    size_t i; 
-
-    // determine clause header information from imported clause
-    if (size == SINGLETON_CLAUSE_SIZE) {
-        memcpy(&clause_id, cls.data(), sizeof(clause_id_t));
-        // skip the clause id.  Glue is 1 for unit.
-        glue = 1;
-        i = 2;
-    } else {
-        memcpy(&clause_id, cls.data() + 1, sizeof(clause_id_t));
-        glue = cls[2];
-        i = 3;
-    }
-    
-    // determine clause body from imported clause, and whether to import it.
-    while (i < size){
-        int elit = cls[i];
-        assert (elit != 0);
-
-        if (external->marked (external->witness, elit)) {
-            // Literal marked as witness: Cannot import
-            return Internal::IMPORT_TYPE::NO_IMPORT;
-        }
-
-        //The only side effects of this are to increase the mapping between internal and external.
-        //Therefore it doesn't matter if we internalize something that isn't going to be imported.
-        int ilit = external->internalize(elit);
-
-        auto& f = flags (ilit);
-        if (f.eliminated () || f.substituted ()) {
-            // Literal has been eliminated or substituted: do not add this clause.
-             return Internal::IMPORT_TYPE::NO_IMPORT;
-        }
-        else if (f.fixed ()){
-            if (val (ilit) == 1) {
-                //fixed and true:  clause is already satisfied, and can be omitted
-              return Internal::IMPORT_TYPE::NO_IMPORT;
-            }
-            else{
-                //clause is false and we need to simplify the clause to import it
-                need_to_simplify = true;
-                int eidx = elit < 0 ? -elit : elit;
-                chain.push_back(external->unit_id[eidx]);
-            }
-        } else{
-            //only include non-fixed literals in the clause
-            // MWW change: need to push back the **INTERNAL** literals
-            // not the **EXTERNAL** literals. 
-            // 
-            // Produced clause should be an internal clause.
-            //
-            clause.push_back(ilit);
-        }
-        i++;
-    }
-    if (need_to_simplify){
-        return Internal::IMPORT_TYPE::SIMPLIFIED_IMPORT;
-    }
-    return Internal::IMPORT_TYPE::DIRECT_IMPORT;
-}
-
-
-void Internal::import_redundant_clauses (int& res) {
-  if (external->learnSource == 0) return;
-  if (res != 0) return;
-
-  // Import external clauses.
-  while (external->learnSource->hasNextClause ()) {
-    // Fetch pointer to 1st literal and size of the clause (plus glue)
-    auto cls = external->learnSource->getNextClause ();
-
-
-    assert (clause.empty ());
-
-    // create_internal_clause overwrites the internal 'clause' member 
-    // that is the placeholder `builder' clause.  Depending on the 
-    // structure of the literals in the external clause, we may decide to 
-    // skip the clause (return NO_IMPORT), directly import the 
-    // clause (return DIRECT_IMPORT), or simplify the clause prior
-    // to importing it (return SIMPLIFIED_IMPORT).
-    int glue;
-    clause_id_t clause_id; 
-    Internal::IMPORT_TYPE importType = 
-      create_internal_clause(cls, clause_id, glue);
-
-    if (importType == Internal::IMPORT_TYPE::NO_IMPORT) {
-      // do nothing
-    } else {
-      // import clause.
-      // First, if we simplify the clause, then the clause is a new
-      // clause, so for the proof we want to derive it from the 
-      // imported clause.  This causes us to give the clause 
-      // a new clause id and glue value. 
-      // 
-      // Then we do different things depending on whether the clause 
-      // after possible simplification contains no literals 
-      // (in which case we are done), one literal (in which case
-      // we import unit), or more than one literal (in which case 
-      // we import a `normal' clause).  We have to track whether 
-      // the clause is a direct import to determine how to represent
-      // it in the proof.  For a direct import, the "reason" comes
-      // from another proof, so we need to track that the clause is 
-      // remote.
-      // For a simplified input clause, the "reason" involves local 
-      // clauses and also the clause id of the remote clause.
-
-      bool is_direct_import; 
-      
-      chain.push_back(clause_id); // Add imported clause to proof of the simplified clause.
-      if (importType == Internal::IMPORT_TYPE::DIRECT_IMPORT) {
-        // use glue and clause_id from the create_clause_id function.
-        is_direct_import = true;
-      } else if (importType == Internal::IMPORT_TYPE::SIMPLIFIED_IMPORT) { // Simplified
-        // Since this is a 'new' clause, we don't have a glue computed, so use the size
-        glue = clause.size();
-        clause_id = next_clause_id();
-        is_direct_import = false;
-      } else {
-        is_direct_import = false;
-        assert(false && "Missing case in import_redundant_clauses function");
-      }
-
-      size_t size = clause.size();
-      if (size == 0){
-          unsat = true;
-          if (proof) proof->add_derived_empty_clause(clause_id);
-      }
-      else if (size == 1){
-          // why do we do both of these?  Ah, one is for the proof, and one is for 
-          // use in solving.
-          if (proof) proof->add_derived_unit_clause(clause_id, clause[0], is_direct_import);          
-          // MWW 9/13/2022: need to add the clause to the chain, in case we derive the empty clause
-          // in assign_original_unit.
-          // Dominik Schreiber 2022-10-05: Store ID in a separate temporary variable
-          // such that it won't be overwritten by intermediate propagation.
-          // TODO Replace with something more robust.
-          assign_original_unit(clause_id, clause[0]);
-      }
-      else{
-          external->check_learned_clause ();
-          Clause *new_built_clause = new_clause(clause_id, true, glue);
-          if (proof) proof->add_derived_clause(new_built_clause, is_direct_import);
-          assert (watching());
-          watch_clause (new_built_clause);
-      }
-    }
-    //we can't need these anymore, so clear them
-    clause.clear();
-    chain.clear();
-
-    // Stop importing if SAT or UNSAT was found
-    if (unsat) {
-      res = 20;
-      return;
-    }
-    if (satisfied ()) {
-      res = 10;
-      return;
-    }
-  }
-}
-
-
-
 /*------------------------------------------------------------------------*/
 
 // Most of the limits are only initialized in the first 'solve' call and
@@ -884,8 +707,11 @@ void Internal::finalize () {
     proof->finalize_clause_ext (id, {lit});
   }
   for (const auto & c : clauses)
-    // See the discussion in 'propagate' on why garbage binary clauses stick around.
-    if (!c->garbage || c->size == 2) proof->finalize_clause (c);
+    if (!c->garbage) proof->finalize_clause (c);
+  for (auto lit : lits)
+    for (const auto & w : binary_watches (lit))
+      if (lit < w.blit)
+        proof->finalize_binary_clause (binary_id (w), lit, w.blit);
 }
 /*------------------------------------------------------------------------*/
 
@@ -910,6 +736,9 @@ void Internal::dump () {
     if (fixed (idx)) m++;
   for (const auto & c : clauses)
     if (!c->garbage) m++;
+  for (auto lit : lits)
+    for (const auto & w : binary_watches (lit))
+      if (lit < w.blit) m++;
   printf ("p cnf %d %" PRId64 "\n", max_var, m);
   for (auto idx : vars) {
     const int tmp = fixed (idx);
@@ -917,6 +746,9 @@ void Internal::dump () {
   }
   for (const auto & c : clauses)
     if (!c->garbage) dump (c);
+  for (auto lit : lits)
+    for (const auto & w : binary_watches (lit))
+      if (lit < w.blit) printf ("%d %d 0\n", lit, w.blit);
   for (const auto & lit : assumptions)
     printf ("%d 0\n", lit);
   fflush (stdout);
@@ -942,6 +774,17 @@ bool Internal::traverse_clauses (ClauseIterator & it) {
       return false;
     eclause.clear ();
   }
+  for (auto lit : lits) {
+    for (const auto & w : binary_watches (lit)) {
+      if (w.redundant) continue;
+      if (lit > w.blit) continue;
+      if (fixed (lit) > 0 || fixed (w.blit) > 0) continue;
+      if (!fixed (lit)) eclause.push_back (externalize (lit));
+      if (!fixed (w.blit)) eclause.push_back (externalize (w.blit));
+      if (!it.clause (eclause)) return false;
+      eclause.clear ();
+    }
+  }
   return true;
 }
 
@@ -47,6 +47,7 @@ extern "C" {
 #include "cadical.hpp"
 #include "checker.hpp"
 #include "clause.hpp"
+#include "clauseid.hpp"
 #include "config.hpp"
 #include "contract.hpp"
 #include "cover.hpp"
@@ -57,6 +58,7 @@ extern "C" {
 #include "flags.hpp"
 #include "format.hpp"
 #include "heap.hpp"
+#include "import.hpp"
 #include "instantiate.hpp"
 #include "internal.hpp"
 #include "level.hpp"
@@ -77,6 +79,8 @@ extern "C" {
 #include "reluctant.hpp"
 #include "resources.hpp"
 #include "score.hpp"
+#include "simd.hpp"
+#include "slab.hpp"
 #include "stats.hpp"
 #include "terminal.hpp"
 #include "tracer.hpp"
@@ -85,6 +89,7 @@ extern "C" {
 #include "version.hpp"
 #include "vivify.hpp"
 #include "watch.hpp"
+#include "workers.hpp"
 #include "reap.hpp"
 
 /*------------------------------------------------------------------------*/
@@ -143,17 +148,22 @@ struct Internal {
   bool lookingahead;            // true during look ahead
   bool preprocessing;           // true during preprocessing
   bool protected_reasons;       // referenced reasons are protected
+  bool explicit_binaries;       // binary clauses allocated as clauses
+  bool watching_clauses;        // clauses are watched
   bool force_saved_phase;       // force saved phase in decision
   bool searching_lucky_phases;  // during 'lucky_phases'
   bool stable;                  // true during stabilization phase
   bool reported;                // reported in this solving call
+#ifdef SIMD
+  bool simd;                    // vectorized replacement search
+#endif
   char rephased;                // last type of resetting phases
   Reluctant reluctant;          // restart counter in stable mode
   size_t vsize;                 // actually allocated variable data size
   int max_var;                  // internal maximum variable index
   int level;                    // decision level ('control.size () - 1')
   clause_id_t original_count;   // count of original clauses
-  clause_id_t learned_count;    // count of learned clauses
+  ClauseIdAllocator clause_ids; // ids of derived clauses
   Phases phases;                // saved, target and best phases
   signed char * vals;           // assignment [-max_var,max_var]
   vector<signed char> marks;    // signed marks [1,max_var]
@@ -173,7 +183,10 @@ struct Internal {
   vector<int> ptab;             // table for caching probing attempts
   vector<int64_t> ntab;         // number of one-sided occurrences table
   vector<Bins> big;             // binary implication graph
-  vector<Watches> wtab;         // table of watches for all literals
+  vector<WatchLists> wtab;      // table of watches for all literals
+  vector<clause_id_t> binary_ids; // identifiers of binary clauses
+  vector<unsigned> binary_refs; // released references to 'binary_ids'
+  int64_t hyper_binaries;       // redundant hyper binary clauses
   Clause * conflict;            // set in 'propagation', reset in 'analyze'
   Clause * ignore;              // ignored during 'vivify_propagate'
   size_t propagated;            // next trail position to propagate
@@ -193,6 +206,8 @@ struct Internal {
 
   vector<int> probes;           // remaining scheduled probes
   vector<clause_id_t> chain;    // clause IDs for derivation chain
+  ImportQueue import_queue;     // queued clauses to import
+  ClauseFingerprints fingerprints; // recently imported or learned clauses
   vector<Level> control;        // 'level + 1 == control.size ()'
   vector<Clause*> clauses;      // ordered collection of all clauses
   Averages averages;            // glue, size, jump moving averages
@@ -209,6 +224,9 @@ struct Internal {
   bool force_phase_messages;    // force 'phase (...)' messages
 #endif
   Arena arena;                  // memory arena for moving garbage collector
+  Slab slab;                    // size class allocator for new clauses
+  Workers workers;              // threads for parallel garbage collection
+  vector<Clause*> copying;      // clauses to be copied by workers
   Format error_message;         // provide persistent error message
   string prefix;                // verbose messages prefix
 
@@ -221,8 +239,11 @@ struct Internal {
       int lit;
       int64_t id;
       const_literal_iterator begin, end;
+      int other;                // instead of literals for binary reasons
   };
   vector<stack_element> justify_todo;
+  vector<int> justified;        // literals marked by 'justify_lit'
+  vector<Clause*> justify_reasons; // saved reasons of learned clause
 
   // Dominik Schreiber 2022-12-15:
   // Required fields previously defined as static fields
@@ -230,6 +251,13 @@ struct Internal {
   Clause decision_reason_clause;
   Clause * decision_reason = &decision_reason_clause;
 
+  // Binary clauses are not allocated (see 'watch.hpp').  Conflicts and
+  // reasons which have to be accessed as clauses in conflict analysis are
+  // copied to these temporary clauses (see 'binary.cpp').
+  //
+  Clause binary_conflict_clause;
+  Clause binary_reason_clause;
+
   /*----------------------------------------------------------------------*/
 
   // Asynchronous termination flag written by 'terminate' and read by
@@ -263,18 +291,27 @@ struct Internal {
   void add_original_lit (int lit);
 
   // Get the next clause ID for a clause read from the input file.
-  // Using this ensures all instances will use the same ID for each
-  // original clause.
+  // Using this ensures all instances will use the same ID for each of the
+  // first 'num_original_clauses' original clauses.  Further original
+  // clauses (all of them if the option is not set) would collide with the
+  // IDs of derived clauses and thus get a new ID too.
   //
   inline clause_id_t next_original_clause_id () {
-    return ++original_count;
+    if (original_count < opts.num_original_clauses) return ++original_count;
+    return next_clause_id ();
   }
 
   // Get the next clause ID for a generated clause in this solver.
   // Should not be used for original clauses.
   //
-  clause_id_t next_clause_id () {
-      return opts.get("num_original_clauses") + opts.get("instance_num") + opts.get("total_instances") * learned_count++;
+  clause_id_t next_clause_id () { return clause_ids.next (); }
+
+  // Copy the parameters of clause ID generation from the options.  Needs
+  // to be called after setting any of these options.
+  //
+  void init_clause_ids () {
+    clause_ids.init (opts.num_original_clauses, opts.instance_num,
+                     opts.total_instances, opts.idblock);
   }
 
   // Enlarge tables.
@@ -355,12 +392,14 @@ struct Internal {
   flags (int lit) const       { return ftab[vidx (lit)]; }
 
   bool occurring () const     { return !otab.empty (); }
-  bool watching () const      { return !wtab.empty (); }
+  bool watching () const      { return watching_clauses; }
 
   Bins & bins (int lit)       { return big[vlit (lit)]; }
   Occs & occs (int lit)       { return otab[vlit (lit)]; }
   int64_t & noccs (int lit)   { return ntab[vlit (lit)]; }
-  Watches & watches (int lit) { return wtab[vlit (lit)]; }
+  Watches & watches (int lit) { return wtab[vlit (lit)].large; }
+
+  Binaries & binary_watches (int lit) { return wtab[vlit (lit)].binary; }
 
   // Variable bumping through exponential VSIDS (EVSIDS) as in MiniSAT.
   //
@@ -465,16 +504,57 @@ struct Internal {
   void unmark_clause ();        // unmark 'this->clause'
   void unmark (Clause *);
 
+  // Create a watch of 'lit' in a clause and access the clause of a watch,
+  // which with compact watches (see 'watch.hpp') goes through the arena.
+  //
+  Watch new_watch (int lit, int blit, Clause * c) const {
+#ifdef COMPACTWATCHES
+    (void) lit;
+    return Watch (blit, arena.offset (c));
+#else
+    int tern = 0;
+    if (c->size == 3) {
+      const int * lits = c->literals;
+      tern = lits[0] ^ lits[1] ^ lits[2] ^ lit ^ blit;
+    }
+    return Watch (blit, c, tern);
+#endif
+  }
+
+  Clause * watched (const Watch & w) const {
+#ifdef COMPACTWATCHES
+    return (Clause *) arena.address (w.ref);
+#else
+    return w.clause;
+#endif
+  }
+
   // Watch literal 'lit' in clause with blocking literal 'blit'.
   // Inlined here, since it occurs in the tight inner loop of 'propagate'.
   //
+  // Binary clauses are only watched as clauses if they are explicit (see
+  // 'make_binaries_explicit' in 'binary.cpp').
+  //
   inline void watch_literal (int lit, int blit, Clause * c) {
     assert (lit != blit);
-    Watches & ws = watches (lit);
-    ws.push_back (Watch (blit, c));
+    assert (c->size > 2 || explicit_binaries);
+    watches (lit).push_back (new_watch (lit, blit, c));
     LOG (c, "watch %d blit %d in", lit, blit);
   }
 
+  // Remove the (unique) watch of 'c' from 'ws'.
+  //
+  void remove_watch (Watches & ws, Clause * c) {
+    const auto end = ws.end ();
+    auto i = ws.begin ();
+    for (auto j = i; j != end; j++) {
+      const Watch & w = *i++ = *j;
+      if (watched (w) == c) i--;
+    }
+    assert (i + 1 == end);
+    ws.resize (i - ws.begin ());
+  }
+
   // Add two watches to a clause.  This is used initially during allocation
   // of a clause and during connecting back all watches after preprocessing.
   //
@@ -519,6 +599,7 @@ struct Internal {
   // Managing clauses in 'clause.cpp'.  Without explicit 'Clause' argument
   // these functions work on the global temporary 'clause'.
   //
+  Clause * allocate_clause (clause_id_t id, bool red, int glue);
   Clause * new_clause (clause_id_t id, bool red, int glue = 0);
   void promote_clause (Clause *, int new_glue);
   size_t shrink_clause (Clause *, int new_size);
@@ -543,15 +624,58 @@ struct Internal {
   void assign_original_unit (clause_id_t, int);
   void add_new_original_clause (clause_id_t);
   Clause * new_learned_redundant_clause (int glue);
-  Clause * new_hyper_binary_resolved_clause (bool red, int glue);
+  clause_id_t new_hyper_binary_resolved_clause (bool red);
   Clause * new_clause_as (const Clause * orig);
   Clause * new_resolved_irredundant_clause ();
 
+  // Implicit binary clauses in 'binary.cpp' (see also 'watch.hpp').
+  //
+  void init_binary_clauses ();
+  unsigned new_binary_ref (clause_id_t);
+  void release_binary_ref (unsigned);
+  clause_id_t binary_id (const Binary & w) const {
+    return w.ref ? binary_ids[w.ref] : 0;
+  }
+  clause_id_t new_binary_clause (clause_id_t, bool red, bool hyper = false);
+  clause_id_t new_derived_binary_clause (bool red, bool hyper = false);
+  void delete_binary (int lit, const Binary &);
+  void remove_binary_watch (int lit, int blit, const Binary &);
+  void delete_binary_clause (int lit, Binary);
+  bool binary_is_reason (int lit, const Binary &);
+  void make_binary_implicit (Clause *);
+  void make_binaries_explicit ();
+  void make_binaries_implicit ();
+
+  // Copy a binary clause to one of the temporary clauses above.
+  //
+  Clause * binary_clause (Clause * c, int a, int b,
+                          clause_id_t id, bool red) {
+    assert (c == &binary_conflict_clause || c == &binary_reason_clause);
+    c->literals[0] = a;
+    c->literals[1] = b;
+    c->id = id;
+    c->redundant = red;
+    return c;
+  }
+
+  // The reason of 'lit' as clause, i.e., binary reasons are copied.
+  //
+  Clause * reason_clause (int lit, Clause * reason, clause_id_t id) {
+    if (!is_binary_reason (reason)) return reason;
+    const int other = binary_reason_literal (reason);
+    return binary_clause (&binary_reason_clause, lit, other, id, false);
+  }
+
+  Clause * reason_clause (int lit) {
+    const Var & v = var (lit);
+    return reason_clause (lit, v.reason, v.binary_id);
+  }
+
   // Forward reasoning through propagation in 'propagate.cpp'.
   //
   int assignment_level (int lit, Clause*);
-  void search_assign (int lit, Clause *);
-  void search_assign_driving (int lit, Clause * reason);
+  void search_assign (int lit, Clause *, clause_id_t = 0);
+  void search_assign_driving (int lit, Clause * reason, clause_id_t = 0);
   void search_assume_decision (int decision);
   void assign_unit (int lit);
   bool propagate ();
@@ -584,10 +708,12 @@ struct Internal {
   void bump_also_all_reason_literals ();
   void analyze_literal (int lit, int & open);
   void analyze_reason (int lit, Clause *, int & open);
-  Clause * new_driving_clause (const int glue, int & jump);
+  Clause * new_driving_clause (const int glue, int & jump, clause_id_t &);
   int find_conflict_level (int & forced);
   int determine_actual_backtrack_level (int jump);
   void build_chain ();
+  void build_chain (const vector<int> & lits, Clause * reason);
+  void build_unit_chain (int lit, Clause * reason);
   void analyze ();
   void iterate ();       // report learned unit clause
 
@@ -652,6 +778,7 @@ struct Internal {
   void protect_reasons ();
   void mark_clauses_to_be_flushed ();
   void mark_useless_redundant_clauses_as_garbage ();
+  int64_t delete_hyper_binary_clauses ();
   bool propagate_out_of_order_units ();
   void unprotect_reasons ();
   void reduce ();
@@ -661,9 +788,10 @@ struct Internal {
   //
   int clause_contains_fixed_literal (Clause *);
   void remove_falsified_literals (Clause *);
-  void mark_satisfied_clauses_as_garbage ();
+  void mark_satisfied_clauses_as_garbage (vector<int> * binary = 0);
   void copy_clause (Clause *);
-  void flush_watches (int lit, Watches &);
+  void copy_moved_clauses ();
+  void flush_watches (int lit);
   size_t flush_occs (int lit);
   void flush_all_occs_and_watches ();
   void update_reason_references ();
@@ -671,8 +799,10 @@ struct Internal {
   void delete_garbage_clauses ();
   void check_clause_stats ();
   void check_var_stats ();
+  void release_slab ();
   bool arenaing ();
   void garbage_collection ();
+  void incremental_garbage_collection ();
 
   // Set-up occurrence list counters and containers.
   //
@@ -687,7 +817,6 @@ struct Internal {
   //
   void init_watches ();
   void connect_watches (bool irredundant_only = false);
-  void sort_watches ();
   void clear_watches ();
   void reset_watches ();
 
@@ -721,9 +850,9 @@ struct Internal {
   bool vivify_all_decisions (Clause * candidate, int subsume);
   void vivify_post_process_analysis (Clause * candidate, int subsume);
   void vivify_strengthen (Clause * candidate);
-  void vivify_assign (int lit, Clause *);
+  void vivify_assign (int lit, Clause *, clause_id_t id = 0);
   void vivify_assume (int lit);
-  bool vivify_propagate ();
+  bool vivify_propagate (bool redundant_mode);
   void vivify_clause (Vivifier &, Clause * candidate);
   void vivify_round (bool redundant_mode, int64_t delta);
   void vivify ();
@@ -856,6 +985,8 @@ struct Internal {
     // Find gates in 'gates.cpp' for bounded variable substitution.
     //
     int second_literal_in_binary_clause(Eliminator &, Clause *, int first);
+    Clause *find_binary_clause_in_occs(int first, int second);
+    void build_hyper_unary_chain(Clause *, Clause *, int first);
     void mark_binary_literals(Eliminator &, int pivot);
     void find_and_gate(Eliminator &, int pivot);
     void find_equivalence(Eliminator &, int pivot);
@@ -891,6 +1022,11 @@ struct Internal {
     void elim_backward_clauses(Eliminator &);
     void elim_propagate(Eliminator &, int unit);
     void elim_on_the_fly_self_subsumption(Eliminator &, Clause *, int);
+    void elim_touched_clause(Eliminator &, Clause *);
+    void elim_reset_checks(Eliminator &);
+    bool elim_check_resolvents(ElimCheck &, vector<signed char> &);
+    void elim_check_candidates(Eliminator &, int idx);
+    bool elim_checked_resolvents(Eliminator &, int pivot, bool &bounded);
     void try_to_eliminate_variable(Eliminator &, int pivot);
     void increase_elimination_bound();
     int elim_round(bool &completed);
@@ -917,14 +1053,15 @@ struct Internal {
     //
     bool probing();
     void failed_literal(int lit);
-    void probe_assign_unit(int lit);
+    void probe_assign_unit(int lit, Clause * reason = 0);
     void probe_assign_decision(int lit);
-    void probe_assign(int lit, int parent);
+    void probe_assign(int lit, int parent, Clause * reason,
+                      clause_id_t id = 0);
     void mark_duplicated_binary_clauses_as_garbage();
     int get_parent_reason_literal(int lit);
     void set_parent_reason_literal(int lit, int reason);
     int probe_dominator(int a, int b);
-    int hyper_binary_resolve(Clause *);
+    int hyper_binary_resolve(Clause *&, clause_id_t &);
     void probe_propagate2();
     bool probe_propagate();
     bool is_binary_clause(Clause * c, int &, int &);
@@ -972,10 +1109,19 @@ struct Internal {
     // Import learnt clauses from an external source.
     bool importing ();
     void import_redundant_clauses (int& res);
+    void import_redundant_clause (const int * cls, size_t size, int& res);
+    bool import_rejected (int glue, int size);
+    bool fingerprinting ();
+    void fingerprint_learned_clause (const int * lits, int size);
+    bool import_duplicated (const int * cls, size_t size);
+    bool better_imported_watch (int a, int b);
+    void watch_imported_clause (Clause *);
+    void receive_redundant_clause (const int * cls, size_t size, int& res);
+    void import_queued_clauses (int& res);
     clause_id_t convert_imported_clause_id (std::vector<int>& cls);
 
     enum IMPORT_TYPE { NO_IMPORT, DIRECT_IMPORT, SIMPLIFIED_IMPORT };
-    IMPORT_TYPE create_internal_clause(std::vector<int> cls, clause_id_t &clause_id, int &glue);
+    IMPORT_TYPE create_internal_clause(const int * cls, size_t size, clause_id_t &clause_id, int &glue);
 
     // Forcing decision variables to a certain phase.
     //
@@ -1099,6 +1245,20 @@ struct Internal {
     return vals[lit];
   }
 
+  // Search for a replacement watch in '[k,end)', i.e., the first literal
+  // not assigned to false, and return 'end' if there is none.
+  //
+  literal_iterator find_non_false (literal_iterator k,
+                                   const_literal_iterator end) const {
+#ifdef SIMD
+    if (simd && end - k >= simd_min_literals)
+      return simd_find_non_false (vals, k, end);
+#endif
+    while (k != end && val (*k) < 0)
+      k++;
+    return k;
+  }
+
   // As 'val' but restricted to the root-level value of a literal.
   // It is not that time critical and also needs to check the decision level
   // of the variable anyhow.
@@ -23,7 +23,7 @@ namespace CaDiCaL {
         if (is_imported){ //only export if not imported
             return;
         }
-        if (!external->learner){ //only learn if a learner exists
+        if (!external->learner && !external->exporter){ //only learn if a learner exists
             return;
         }
         if (glue == -1){
@@ -47,7 +47,7 @@ namespace CaDiCaL {
     void LearnerObserver::add_todo (const vector<int64_t> &){ }
 
     bool LearnerObserver::closed (){
-        return !external->learner;
+        return !external->learner && !external->exporter;
     }
 
     void LearnerObserver::close (){
@@ -47,9 +47,9 @@ struct Last {
   struct { int64_t propagations; } transred, vivify;
   struct { int64_t fixed, subsumephases, marked; } elim;
   struct { int64_t propagations, reductions; } probe;
-  struct { int64_t conflicts; } reduce, rephase;
+  struct { int64_t conflicts; } reduce, rephase, import;
   struct { int64_t marked; } ternary;
-  struct { int64_t fixed; } collect;
+  struct { int64_t fixed; size_t clause; } collect;
   Last ();
 };
 
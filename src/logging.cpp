@@ -49,7 +49,9 @@ void Logger::log (Internal * internal,
   va_start (ap, fmt);
   vprintf (fmt, ap);
   va_end (ap);
-  if (c) {
+  if (is_binary_reason (c))
+    printf (" binary reason with %d", binary_reason_literal (c));
+  else if (c) {
     if (c->redundant) printf (" glue %d redundant", c->glue);
     else printf (" irredundant");
     printf (" size %d clause[%" PRId64 "]", c->size, c->id);
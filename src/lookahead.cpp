@@ -55,6 +55,11 @@ int Internal::most_occurring_literal () {
       for (const auto & lit : *c)
         if (active (lit))
           noccs (lit)++;
+  for (auto lit : lits)
+    if (active (lit))
+      for (const auto & w : binary_watches (lit))
+        if (!w.redundant)
+          noccs (lit)++;
   int64_t max_noccs = 0;
   int res = 0;
 
@@ -105,6 +110,14 @@ void Internal::lookahead_flush_probes () {
     noccs (a)++;
     noccs (b)++;
   }
+  for (auto lit : lits) {
+    if (val (lit)) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (lit > w.blit || val (w.blit)) continue;
+      noccs (lit)++;
+      noccs (w.blit)++;
+    }
+  }
 
   const auto eop = probes.end ();
   auto j = probes.begin ();
@@ -151,6 +164,14 @@ void Internal::lookahead_generate_probes () {
     noccs (a)++;
     noccs (b)++;
   }
+  for (auto lit : lits) {
+    if (val (lit)) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (lit > w.blit || val (w.blit)) continue;
+      noccs (lit)++;
+      noccs (w.blit)++;
+    }
+  }
 
   for (int idx = 1; idx <= max_var; idx++) {
 
@@ -364,7 +385,7 @@ int Internal::lookahead_probing() {
       MSG ("propagating units after probing results in empty clause");
       learn_empty_clause ();
       res = INT_MIN;
-    } else sort_watches ();
+    }
   }
 
 #ifndef QUIET
@@ -0,0 +1,544 @@
+/*------------------------------------------------------------------------*/
+
+// Stand alone checker for LRAT proofs as written by 'Tracer' (or merged by
+// 'lratmerge').  Unlike the internal 'Checker', which checks DRAT proofs by
+// propagating over all clauses, checking LRAT proofs only needs to go over
+// the hints (antecedents) of each lemma in the given order, which all have
+// to become unit until the last one is falsified.  No propagation search
+// is needed.
+//
+// The proof is read once (memory mapped if uncompressed) and all clauses
+// are stored in one literal arena.  While reading we already resolve the
+// clause identifiers of hints to clause indices and check that they refer
+// to existing clauses which have not been deleted yet.  Since the checks of
+// the hint chains of different lemmas then only depend on the literals of
+// their antecedents, but not on whether these antecedents were checked
+// before, they are independent and are split across several threads.
+//
+// Lemmas are checked in windows.  As soon as the hints of the current
+// window and the literals of clauses deleted in it outgrow the live
+// clauses, the window is checked, the deleted clauses are reclaimed and
+// the arena is compacted.  Thus peak memory follows the live clauses
+// instead of the length of the proof.
+
+namespace CaDiCaL {
+
+static const char * USAGE =
+"usage: lratcheck [ <option> ... ] <dimacs> <proof>\n"
+"\n"
+"where '<option>' is one of the following\n"
+"\n"
+"  -h | --help      print this command line option summary\n"
+"  --version        print version\n"
+"  -q | --quiet     do not print any messages\n"
+"\n"
+"  --binary         proof is in binary format\n"
+"  --delta          binary LRAT proof has delta encoded identifiers\n"
+"  --frat           proof is in FRAT format (default LRAT)\n"
+"  --threads=<n>    number of checking threads (default all cores)\n"
+"\n"
+"The exit code is zero if the proof derives the empty clause and all its\n"
+"lemmas are correct and '1' otherwise.  Both the formula '<dimacs>' and\n"
+"the '<proof>' can be compressed.  Only RUP steps are supported.\n"
+;
+
+}
+
+/*------------------------------------------------------------------------*/
+
+#include "internal.hpp"
+#include "lratreader.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <cstdarg>
+#include <cstring>
+
+#ifndef NTHREADS
+#include <thread>
+#endif
+
+/*------------------------------------------------------------------------*/
+namespace CaDiCaL {
+/*------------------------------------------------------------------------*/
+
+static bool quiet;
+
+static void msg (const char * fmt, ...) {
+  if (quiet) return;
+  fputs ("c ", stdout);
+  va_list ap;
+  va_start (ap, fmt);
+  vprintf (fmt, ap);
+  va_end (ap);
+  fputc ('\n', stdout);
+  fflush (stdout);
+}
+
+static void die (const char * fmt, ...) {
+  fputs ("lratcheck: error: ", stderr);
+  va_list ap;
+  va_start (ap, fmt);
+  vfprintf (stderr, fmt, ap);
+  va_end (ap);
+  fputc ('\n', stderr);
+  exit (1);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Maps identifiers of live clauses to their indices.  Identifiers can be
+// arbitrarily large and sparse (for instance if blocks of identifiers are
+// spread across instances), thus we use hashing with linear probing,
+// which keeps the table proportional to the number of live clauses.
+// Removed entries are filled by shifting back later entries of the same
+// probe sequence (no tombstones).  Zero identifiers mark empty entries.
+
+class IdTable {
+
+  struct Entry { int64_t id; uint32_t idx; };
+
+  vector<Entry> table;
+  uint64_t count, mask;
+
+  uint64_t hash (int64_t id) const {
+    return ((uint64_t) id * 0x9e3779b97f4a7c15ull) >> 20;
+  }
+
+  void resize (uint64_t size) {
+    vector<Entry> old (size, Entry { 0, 0 });
+    old.swap (table);
+    mask = size - 1;
+    for (const auto & e : old)
+      if (e.id) {
+        uint64_t pos = hash (e.id) & mask;
+        while (table[pos].id) pos = (pos + 1) & mask;
+        table[pos] = e;
+      }
+  }
+
+  uint64_t find (int64_t id) const {
+    uint64_t pos = hash (id) & mask;
+    while (table[pos].id && table[pos].id != id) pos = (pos + 1) & mask;
+    return pos;
+  }
+
+public:
+
+  IdTable () : table (16, Entry { 0, 0 }), count (0), mask (15) { }
+
+  uint32_t get (int64_t id) const {
+    assert (id > 0);
+    return table[find (id)].idx;
+  }
+
+  void insert (int64_t id, uint32_t idx) {
+    assert (id > 0), assert (idx);
+    if (2*(count + 1) > table.size ()) resize (2*table.size ());
+    Entry & e = table[find (id)];
+    assert (!e.id);
+    e.id = id, e.idx = idx;
+    count++;
+  }
+
+  // Returns the index of the removed clause or zero if there is none.
+
+  uint32_t remove (int64_t id) {
+    assert (id > 0);
+    uint64_t pos = find (id);
+    const uint32_t res = table[pos].idx;
+    if (!res) return 0;
+    for (uint64_t next = (pos + 1) & mask; table[next].id;
+         next = (next + 1) & mask) {
+      const uint64_t home = hash (table[next].id) & mask;
+      if (((next - home) & mask) < ((next - pos) & mask)) continue;
+      table[pos] = table[next];
+      pos = next;
+    }
+    table[pos] = Entry { 0, 0 };
+    count--;
+    if (table.size () > 16 && 8*count < table.size ())
+      resize (table.size () / 2);
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+class LratCheck {
+
+  bool binary, delta, frat;
+  unsigned threads;
+
+  // Clauses are numbered by indices starting with the original clauses at
+  // index '1' (thus original clause 'i' has index 'i').  Indices of
+  // reclaimed clauses are reused.  In 'literals' each clause is preceded
+  // by its index (to compact the arena) and zero terminated.  Hints are
+  // zero terminated too.  The last four vectors only cover the lemmas of
+  // the current window.
+
+  vector<int> literals;         // literals of all live clauses
+  vector<uint64_t> clauses;     // start of clause in 'literals' or zero
+  IdTable indices;              // index of live clauses by identifier
+  vector<uint32_t> unused;      // reclaimed clause indices
+  vector<uint32_t> deleted;     // clauses deleted in current window
+  uint64_t garbage;             // words of clauses in 'deleted'
+  vector<uint32_t> hints;       // hints of lemmas as clause indices
+  vector<uint64_t> lemmas;      // start of hints of lemma in 'hints'
+  vector<uint32_t> lemma_clauses; // clause index of lemma
+  vector<int64_t> ids;          // identifiers of lemmas (for errors)
+  int max_var;
+  bool inconsistent;            // formula contains the empty clause
+
+  std::atomic<uint64_t> next;   // next lemma to check
+  std::atomic<uint64_t> failed; // first failed lemma
+
+  struct {
+    int64_t deleted, ignored;   // deleted and ignored deletions
+    int64_t lemmas, hints;      // read lemmas and hints
+    int64_t windows;            // checked windows
+    int64_t reclaimed;          // reclaimed words of deleted clauses
+  } stats;
+
+  uint32_t index (int64_t id) const {
+    return id > 0 ? indices.get (id) : 0;
+  }
+
+  uint64_t size (uint32_t idx) const;
+  uint32_t new_clause (int64_t id, const vector<int> & lits);
+  void delete_clause (int64_t id);
+
+  void read_formula (const char * path);
+  bool read_proof (const char * path);
+
+  bool check (uint64_t lemma, vector<signed char> & vals,
+              vector<int> & trail) const;
+  void check_lemmas ();
+  bool window_full () const;
+  bool check_window ();
+  void compact ();
+
+public:
+
+  LratCheck ();
+
+  int main (int argc, char ** argv);
+};
+
+/*------------------------------------------------------------------------*/
+
+LratCheck::LratCheck () :
+  binary (false), delta (false), frat (false), threads (1),
+  garbage (0), max_var (0), inconsistent (false),
+  next (0), failed (UINT64_MAX)
+{
+  memset (&stats, 0, sizeof stats);
+#ifndef NTHREADS
+  threads = max (1u, std::thread::hardware_concurrency ());
+#endif
+}
+
+// Number of words of the clause in 'literals' including its index and the
+// terminating zero.
+
+uint64_t LratCheck::size (uint32_t idx) const {
+  const int * begin = literals.data () + clauses[idx], * p = begin;
+  while (*p) p++;
+  return p - begin + 2;
+}
+
+uint32_t LratCheck::new_clause (int64_t id, const vector<int> & lits) {
+  uint32_t res;
+  if (!unused.empty ()) res = unused.back (), unused.pop_back ();
+  else if (clauses.size () == UINT32_MAX) die ("too many clauses");
+  else res = clauses.size (), clauses.push_back (0);
+  literals.push_back ((int) res);
+  clauses[res] = literals.size ();
+  for (const auto & lit : lits) {
+    literals.push_back (lit);
+    if (abs (lit) > max_var) max_var = abs (lit);
+  }
+  literals.push_back (0);
+  indices.insert (id, res);
+  return res;
+}
+
+// Deleted clauses might still be antecedents of lemmas in the current
+// window and thus are only reclaimed after the window has been checked.
+
+void LratCheck::delete_clause (int64_t id) {
+  const uint32_t idx = id > 0 ? indices.remove (id) : 0;
+  if (!idx) { stats.ignored++; return; }
+  deleted.push_back (idx);
+  garbage += size (idx);
+  stats.deleted++;
+}
+
+void LratCheck::read_formula (const char * path) {
+  vector<int> dimacs;
+  const int64_t original = read_dimacs (path, dimacs);
+  if (original < 0) die ("can not read DIMACS file '%s'", path);
+  clauses.push_back (0);                // index zero is invalid
+  vector<int> lits;
+  int64_t id = 0;
+  for (const auto & lit : dimacs)
+    if (lit) lits.push_back (lit);
+    else {
+      if (lits.empty ()) inconsistent = true;
+      new_clause (++id, lits), lits.clear ();
+    }
+  assert (id == original);
+  msg ("read %" PRId64 " original clauses from '%s'", original, path);
+}
+
+// Returns 'true' if the proof derives the empty clause and all lemmas are
+// correct.
+
+bool LratCheck::read_proof (const char * path) {
+  LratReader reader;
+  if (!reader.open (path, binary, frat, delta))
+    die ("can not read '%s'", path);
+  msg ("reading %s proof from %s'%s'",
+    delta ? "delta encoded binary" : binary ? "binary" : "ASCII",
+    reader.memory_mapped () ? "memory mapped " : "", reader.name ());
+  LratStep step;
+  // An empty original clause is as good as a derived empty clause.
+  bool empty = inconsistent, verified = true;
+  if (empty) msg ("formula contains the empty clause");
+  while (verified && !empty) {
+    LratStep::Type type = reader.next (step, true);
+    if (type == LratStep::END) break;
+    if (type == LratStep::ERROR) die ("parse error: %s", reader.error ());
+    if (type == LratStep::DELETE) {
+      for (const auto & id : step.hints) delete_clause (id);
+      if (window_full ()) verified = check_window ();
+      continue;
+    }
+    if (type != LratStep::ADD) continue;
+    if (index (step.id))
+      die ("%s: lemma %" PRId64 " added twice", reader.name (), step.id);
+    lemmas.push_back (hints.size ());
+    for (const auto & hint : step.hints) {
+      if (hint < 0)
+        die ("%s: RAT hint %" PRId64 " in lemma %" PRId64
+          " not supported", reader.name (), hint, step.id);
+      const uint32_t idx = index (hint);
+      if (!idx)
+        die ("%s: hint %" PRId64 " in lemma %" PRId64
+          " is not an original clause, earlier lemma or was deleted",
+          reader.name (), hint, step.id);
+      hints.push_back (idx);
+    }
+    stats.hints += step.hints.size ();
+    hints.push_back (0);
+    ids.push_back (step.id);
+    lemma_clauses.push_back (new_clause (step.id, step.lits));
+    stats.lemmas++;
+    empty = step.lits.empty ();
+    if (window_full ()) verified = check_window ();
+  }
+  if (verified) verified = check_window ();
+  msg ("read %" PRId64 " lemmas with %" PRId64 " hints and %" PRId64
+    " deletions", stats.lemmas, stats.hints, stats.deleted);
+  if (stats.ignored)
+    msg ("ignored %" PRId64 " deletions of unknown clauses", stats.ignored);
+  msg ("checked %" PRId64 " windows and reclaimed %.0f MB of deleted clauses",
+    stats.windows, stats.reclaimed * sizeof (int) / (double) (1 << 20));
+  if (verified && !empty) {
+    msg ("proof does not derive the empty clause");
+    verified = false;
+  }
+  return verified;
+}
+
+/*------------------------------------------------------------------------*/
+
+// The window is checked as soon as its hints and deleted clauses take more
+// space than the live clauses, which bounds memory by a constant factor of
+// the live clauses while the amortized cost of compacting stays linear.
+
+bool LratCheck::window_full () const {
+  const uint64_t pending = hints.size () + garbage;
+  const uint64_t live = literals.size () - garbage;
+  return pending > max (live, (uint64_t) 1 << 22);
+}
+
+// Returns 'false' if a lemma in the window failed.
+
+bool LratCheck::check_window () {
+  if (!lemmas.empty ()) {
+    lemmas.push_back (hints.size ());
+    check_lemmas ();
+    stats.windows++;
+    const uint64_t lemma = failed;
+    if (lemma != UINT64_MAX) {
+      msg ("lemma %" PRId64 " failed", ids[lemma]);
+      return false;
+    }
+    next = 0;
+    hints.clear ();
+    lemmas.clear ();
+    lemma_clauses.clear ();
+    ids.clear ();
+  }
+  if (!deleted.empty ()) {
+    for (const auto & idx : deleted) {
+      clauses[idx] = 0;
+      unused.push_back (idx);
+    }
+    deleted.clear ();
+    compact ();
+  }
+  return true;
+}
+
+// Move live clauses to the front of the arena.  Since each clause is
+// preceded by its index we can walk the arena in order and find out whether
+// the clause at that position is still live.
+
+void LratCheck::compact () {
+  const uint64_t size = literals.size ();
+  uint64_t i = 0, j = 0;
+  while (i < size) {
+    const uint32_t idx = (uint32_t) literals[i++];
+    const bool live = clauses[idx] == i;
+    if (live) literals[j++] = (int) idx, clauses[idx] = j;
+    int lit;
+    do {
+      lit = literals[i++];
+      if (live) literals[j++] = lit;
+    } while (lit);
+  }
+  stats.reclaimed += size - j;
+  literals.resize (j);
+  shrink_vector (literals);
+  garbage = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Assign the negation of the lemma and then all hints except the last one
+// have to be unit and the last one has to be falsified.
+
+bool LratCheck::check (uint64_t lemma, vector<signed char> & vals,
+                       vector<int> & trail) const {
+  auto val = [&vals] (int lit) {
+    return lit < 0 ? -vals[-lit] : vals[lit];
+  };
+  auto assign = [&vals, &trail] (int lit) {
+    vals[abs (lit)] = lit < 0 ? -1 : 1;
+    trail.push_back (lit);
+  };
+  bool res = false;
+  const int * lits = literals.data () + clauses[lemma_clauses[lemma]];
+  for (const int * p = lits; !res && *p; p++) {
+    const int tmp = val (*p);
+    if (tmp > 0) res = true;            // tautological lemma
+    else if (!tmp) assign (-*p);
+  }
+  const uint32_t * q = hints.data () + lemmas[lemma];
+  for (; !res && *q; q++) {
+    int unit = 0;
+    bool invalid = false;               // neither unit nor falsified
+    for (const int * p = literals.data () + clauses[*q]; *p; p++) {
+      const int tmp = val (*p);
+      if (tmp < 0) continue;
+      if (tmp > 0 || (unit && unit != *p)) { invalid = true; break; }
+      unit = *p;
+    }
+    if (invalid) break;
+    if (!unit) res = true;              // conflict
+    else assign (unit);
+  }
+  for (const auto & lit : trail) vals[abs (lit)] = 0;
+  trail.clear ();
+  return res;
+}
+
+void LratCheck::check_lemmas () {
+  const uint64_t n = lemmas.size () - 1;
+  const uint64_t chunk = 1024;
+  auto worker = [this, n, chunk] () {
+    vector<signed char> vals (max_var + 1);
+    vector<int> trail;
+    for (;;) {
+      const uint64_t begin = next.fetch_add (chunk);
+      if (begin >= n || begin > failed.load (std::memory_order_relaxed))
+        break;
+      const uint64_t end = min (begin + chunk, n);
+      for (uint64_t lemma = begin; lemma < end; lemma++) {
+        if (check (lemma, vals, trail)) continue;
+        uint64_t expected = failed.load ();
+        while (lemma < expected &&
+               !failed.compare_exchange_weak (expected, lemma))
+          ;
+        break;
+      }
+    }
+  };
+  if (threads > n / chunk + 1) threads = n / chunk + 1;
+  msg ("checking %" PRIu64 " lemmas with %u threads", n, threads);
+#ifndef NTHREADS
+  vector<std::thread> workers;
+  for (unsigned i = 1; i < threads; i++) workers.emplace_back (worker);
+  worker ();
+  for (auto & w : workers) w.join ();
+#else
+  worker ();
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
+int LratCheck::main (int argc, char ** argv) {
+  const char * dimacs_path = 0, * proof_path = 0;
+  for (int i = 1; i < argc; i++) {
+    const char * arg = argv[i];
+    if (!strcmp (arg, "-h") || !strcmp (arg, "--help")) {
+      fputs (USAGE, stdout);
+      return 0;
+    } else if (!strcmp (arg, "--version")) {
+      printf ("%s\n", version ());
+      return 0;
+    } else if (!strcmp (arg, "-q") || !strcmp (arg, "--quiet"))
+      quiet = true;
+    else if (!strcmp (arg, "--binary")) binary = true;
+    else if (!strcmp (arg, "--delta")) binary = delta = true;
+    else if (!strcmp (arg, "--frat")) frat = true;
+    else if (!strncmp (arg, "--threads=", 10)) {
+      threads = atoi (arg + 10);
+      if (!threads) die ("invalid number of threads in '%s'", arg);
+#ifdef NTHREADS
+      if (threads > 1) die ("compiled without thread support");
+#endif
+    } else if (arg[0] == '-' && arg[1])
+      die ("invalid option '%s' (try '-h')", arg);
+    else if (!dimacs_path) dimacs_path = arg;
+    else if (!proof_path) proof_path = arg;
+    else die ("too many arguments (try '-h')");
+  }
+  if (!dimacs_path) die ("no DIMACS file specified (try '-h')");
+  if (!proof_path) die ("no proof specified (try '-h')");
+
+  msg ("LratCheck Proof Checker for CaDiCaL Version %s", version ());
+  double start = absolute_real_time ();
+  read_formula (dimacs_path);
+  const int res = !read_proof (proof_path);
+  msg ("reading and checking took %.2f seconds",
+    absolute_real_time () - start);
+  msg ("maximum resident set size of %.0f MB",
+    maximum_resident_set_size () / (double) (1 << 20));
+  printf ("s %s\n", res ? "NOT VERIFIED" : "VERIFIED");
+  fflush (stdout);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+}
+
+int main (int argc, char ** argv) {
+  CaDiCaL::LratCheck check;
+  return check.main (argc, argv);
+}
@@ -0,0 +1,576 @@
+/*------------------------------------------------------------------------*/
+
+// Merges the LRAT (or FRAT) proofs of several solver instances which
+// shared clauses while solving the same formula into one LRAT proof.
+
+// Each instance writes its own proof with globally unique clause
+// identifiers (see 'ClauseIdAllocator').  Imported clauses are not traced
+// ('Tracer' skips them) and thus hints of later steps refer to clauses
+// derived in the proof of another instance.  Proofs can be huge.  So they
+// are streamed and the clauses are never kept in memory.  Only two bits
+// per clause identifier are needed in memory and all the rest is kept in
+// temporary files on disk ('Spool'), which are read backward.
+//
+// First the proofs are merged into one sequence in which every clause is
+// added after all its antecedents.  This is a multi-way merge of sorted
+// runs, similar to the merge phase of external sorting, since each single
+// proof already is topologically sorted.  Merging stops at the first
+// derived empty clause.  Second this sequence is traversed backward from
+// the empty clause to mark antecedents and thus prune unused derivations.
+// This backward pass also determines the last use of each clause, after
+// which it can be deleted.  Finally the result is traversed backward again
+// (thus forward in the original order) and written as LRAT proof.
+
+namespace CaDiCaL {
+
+static const char * USAGE =
+"usage: lratmerge [ <option> ... ] <dimacs> <proof> [ <proof> ... ]\n"
+"\n"
+"where '<option>' is one of the following\n"
+"\n"
+"  -h | --help      print this command line option summary\n"
+"  --version        print version\n"
+"  -q | --quiet     do not print any messages\n"
+"\n"
+"  --binary         input proofs are in binary format\n"
+"  --delta          input proofs are delta encoded binary LRAT\n"
+"  --frat           input proofs are in FRAT format (default LRAT)\n"
+"\n"
+"  -o <output>      write merged proof to '<output>' (default '<stdout>')\n"
+"  --binary-output  write merged proof in binary LRAT format\n"
+"  --delta-output   write merged proof in delta encoded binary LRAT\n"
+"  --no-deletions   do not add deletion steps to merged proof\n"
+"  --tmp=<dir>      directory for temporary files (default '/tmp')\n"
+"\n"
+"The '<dimacs>' file is the formula and is only used to determine the\n"
+"number of original clauses.  Each '<proof>' is the proof of one solver\n"
+"instance traced with '--lrat=true' (or also '--frat=true').  Proofs and\n"
+"the formula can be compressed.\n"
+;
+
+}
+
+/*------------------------------------------------------------------------*/
+
+#include "internal.hpp"
+#include "lratreader.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <cstdarg>
+#include <cstring>
+
+/*------------------------------------------------------------------------*/
+
+extern "C" {
+#include <stdlib.h>
+#include <unistd.h>
+}
+
+/*------------------------------------------------------------------------*/
+namespace CaDiCaL {
+/*------------------------------------------------------------------------*/
+
+static bool quiet;
+static FILE * messages = stdout;
+
+static void msg (const char * fmt, ...) {
+  if (quiet) return;
+  fputs ("c ", messages);
+  va_list ap;
+  va_start (ap, fmt);
+  vfprintf (messages, fmt, ap);
+  va_end (ap);
+  fputc ('\n', messages);
+  fflush (messages);
+}
+
+static void die (const char * fmt, ...) {
+  fputs ("lratmerge: error: ", stderr);
+  va_list ap;
+  va_start (ap, fmt);
+  vfprintf (stderr, fmt, ap);
+  va_end (ap);
+  fputc ('\n', stderr);
+  exit (1);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Growable bit set indexed by clause identifiers.
+
+class ClauseBits {
+  vector<uint64_t> words;
+public:
+  bool operator [] (int64_t id) const {
+    const uint64_t w = id >> 6;
+    return w < words.size () && ((words[w] >> (id & 63)) & 1);
+  }
+  void set (int64_t id) {
+    const uint64_t w = id >> 6;
+    if (w >= words.size ()) words.resize (2*w + 1);
+    words[w] |= (uint64_t) 1 << (id & 63);
+  }
+  void clear () { erase_vector (words); }
+  size_t bytes () const { return words.capacity () * sizeof (uint64_t); }
+};
+
+/*------------------------------------------------------------------------*/
+
+// Temporary file of proof steps, which is written forward and read
+// backward.  Each record is encoded with variable length integers followed
+// by the length of the encoding in four bytes.  Reading backward goes
+// through a window of at least 'window_size' bytes.
+
+class Spool {
+
+  static const size_t window_size = 1 << 22;
+
+  FILE * file;
+  uint64_t size;                        // bytes written
+
+  vector<unsigned char> buffer;         // encoded record
+
+  uint64_t position;                    // end of next record to read
+  uint64_t window_start;                // file offset of 'window[0]'
+  vector<unsigned char> window;
+
+  void encode_unsigned (uint64_t n) {
+    while (n & ~0x7f) buffer.push_back ((n & 0x7f) | 0x80), n >>= 7;
+    buffer.push_back (n);
+  }
+
+  void encode_signed (int64_t n) {
+    encode_unsigned (n < 0 ? 2*(uint64_t) -n + 1 : 2*(uint64_t) n);
+  }
+
+  uint64_t decode_unsigned (const unsigned char * & p) {
+    uint64_t res = 0;
+    unsigned shift = 0;
+    do res |= (uint64_t) (*p & 0x7f) << shift, shift += 7;
+    while (*p++ & 0x80);
+    return res;
+  }
+
+  int64_t decode_signed (const unsigned char * & p) {
+    uint64_t u = decode_unsigned (p);
+    return (u & 1) ? - (int64_t) (u >> 1) : (int64_t) (u >> 1);
+  }
+
+  // Make sure the file range '[from, to)' is in the window.
+  //
+  const unsigned char * load (uint64_t from, uint64_t to) {
+    assert (from <= to), assert (to <= size);
+    if (from < window_start || to > window_start + window.size ()) {
+      uint64_t bytes = max ((uint64_t) window_size, to - from);
+      window_start = to < bytes ? 0 : to - bytes;
+      window.resize (to - window_start);
+      if (fseeko (file, window_start, SEEK_SET) ||
+          fread (window.data (), window.size (), 1, file) != 1)
+        die ("failed to read temporary file");
+    }
+    return window.data () + (from - window_start);
+  }
+
+public:
+
+  Spool () : file (0), size (0), position (0), window_start (0) { }
+  ~Spool () { if (file) fclose (file); }
+
+  void open (const char * dir) {
+    string path = string (dir) + "/lratmerge-XXXXXX";
+    int fd = mkstemp (&path[0]);
+    if (fd < 0 || !(file = fdopen (fd, "w+")))
+      die ("can not create temporary file in '%s'", dir);
+    unlink (path.c_str ());
+  }
+
+  uint64_t bytes () const { return size; }
+
+  void write (const LratStep & step, const vector<int64_t> & deletions) {
+    buffer.clear ();
+    encode_unsigned (step.id);
+    encode_unsigned (step.lits.size ());
+    for (const auto & lit : step.lits) encode_signed (lit);
+    encode_unsigned (step.hints.size ());
+    for (const auto & hint : step.hints) encode_signed (hint);
+    encode_unsigned (deletions.size ());
+    for (const auto & id : deletions) encode_unsigned (id);
+    const uint32_t len = buffer.size ();
+    for (unsigned i = 0; i < 4; i++) buffer.push_back (len >> (8*i));
+    if (fwrite (buffer.data (), buffer.size (), 1, file) != 1)
+      die ("failed to write temporary file");
+    size += buffer.size ();
+  }
+
+  // Start reading backward from the last record.
+  //
+  void rewind () {
+    if (fflush (file)) die ("failed to write temporary file");
+    position = size;
+    window_start = 0;
+    window.clear ();
+  }
+
+  bool read_backward (LratStep & step, vector<int64_t> & deletions) {
+    if (!position) return false;
+    assert (position >= 4);
+    const unsigned char * p = load (position - 4, position);
+    uint32_t len = 0;
+    for (unsigned i = 0; i < 4; i++) len |= (uint32_t) p[i] << (8*i);
+    assert (len + 4 <= position);
+    position -= len + 4;
+    p = load (position, position + len);
+    step.type = LratStep::ADD;
+    step.id = decode_unsigned (p);
+    step.lits.resize (decode_unsigned (p));
+    for (auto & lit : step.lits) lit = decode_signed (p);
+    step.hints.resize (decode_unsigned (p));
+    for (auto & hint : step.hints) hint = decode_signed (p);
+    deletions.resize (decode_unsigned (p));
+    for (auto & id : deletions) id = decode_unsigned (p);
+    return true;
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+// Buffered output of the merged proof ('File' needs an 'Internal').
+
+class Output {
+
+  FILE * file;
+  const char * path;
+
+public:
+
+  Output (const char * p) : path (p ? p : "<stdout>") {
+    if (!p) file = stdout;
+    else if (!(file = fopen (p, "w"))) die ("can not write '%s'", p);
+  }
+
+  const char * name () const { return path; }
+
+  void put (char ch) { cadical_putc_unlocked (ch, file); }
+
+  void put (int64_t n) {
+    char buffer[21];
+    int i = sizeof buffer;
+    uint64_t k = n < 0 ? - (uint64_t) n : n;
+    do buffer[--i] = '0' + k % 10, k /= 10;
+    while (k);
+    if (n < 0) put ('-');
+    while (i < (int) sizeof buffer) put (buffer[i++]);
+  }
+
+  void put_binary_unsigned (uint64_t n) {
+    while (n & ~0x7f) put ((char) ((n & 0x7f) | 0x80)), n >>= 7;
+    put ((char) n);
+  }
+
+  void put_binary_signed (int64_t n) {
+    put_binary_unsigned (n < 0 ? 2*(uint64_t) -n + 1 : 2*(uint64_t) n);
+  }
+
+  // Absolute or relative to 'base' as in delta encoded LRAT of 'cadical'.
+
+  void put_binary_delta (int64_t base, int64_t id) {
+    const int64_t a = id < 0 ? -id : id, d = base - a;
+    const int64_t v = (0 < d && d < a) ? 2*d + 1 : 2*a;
+    put_binary_signed (id < 0 ? -v : v);
+  }
+
+  void close () {
+    if (fflush (file) || ferror (file))
+      die ("failed to write merged proof to '%s'", path);
+    if (file != stdout) fclose (file);
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+// One input proof with at most one pending step, which can not be merged
+// yet because some of its antecedents have not been merged.
+
+struct MergeInput {
+  LratReader reader;
+  LratStep step;
+  bool pending, done;
+  int64_t added, merged;
+  MergeInput () : pending (false), done (false), added (0), merged (0) { }
+};
+
+class LratMerge {
+
+  bool binary, delta, frat;             // input format
+  bool binary_output, delta_output, deletions;
+  const char * tmp;
+  const char * output_path;
+  int64_t original;                     // number of original clauses
+
+  vector<MergeInput *> inputs;
+  ClauseBits bits;                      // first merged then needed
+  Spool merged, pruned;
+  int64_t empty;                        // identifier of empty clause
+
+  struct {
+    int64_t merged, pruned, deleted, written;
+    size_t bits;
+  } stats;
+
+  bool antecedent (int64_t id) const {
+    id = abs (id);
+    return id <= original || bits[id];
+  }
+
+  bool ready (const LratStep & step) const {
+    for (const auto & hint : step.hints)
+      if (!antecedent (hint)) return false;
+    return true;
+  }
+
+  int64_t missing (const LratStep & step) const {
+    for (const auto & hint : step.hints)
+      if (!antecedent (hint)) return abs (hint);
+    return 0;
+  }
+
+  void merge ();
+  void prune ();
+  void write ();
+
+public:
+
+  LratMerge ();
+  ~LratMerge ();
+
+  int main (int argc, char ** argv);
+};
+
+/*------------------------------------------------------------------------*/
+
+LratMerge::LratMerge () :
+  binary (false), delta (false), frat (false),
+  binary_output (false), delta_output (false), deletions (true),
+  tmp (0), output_path (0), original (0), empty (0)
+{
+  memset (&stats, 0, sizeof stats);
+}
+
+LratMerge::~LratMerge () {
+  for (const auto & input : inputs) delete input;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Round-robin over the inputs and move as many steps as possible from each
+// of them to the merged sequence.  If no input makes progress in a full
+// round then the proofs are incomplete or have cyclic dependencies.
+
+void LratMerge::merge () {
+  msg ("merging %zd proofs", inputs.size ());
+  merged.open (tmp);
+  const vector<int64_t> no_deletions;
+  while (!empty) {
+    bool progress = false;
+    for (auto & input : inputs) {
+      LratStep & step = input->step;
+      while (!empty && !input->done) {
+        if (!input->pending) {
+          LratStep::Type type = input->reader.next (step);
+          if (type == LratStep::ERROR)
+            die ("parse error: %s", input->reader.error ());
+          if (type == LratStep::END) {
+            msg ("read %" PRId64 " derived clauses from '%s'",
+              input->added, input->reader.name ());
+            input->reader.close ();
+            input->done = true;
+            break;
+          }
+          if (type != LratStep::ADD) continue;
+          if (step.id <= original || bits[step.id])
+            die ("%s: clause %" PRId64 " added twice",
+              input->reader.name (), step.id);
+          input->added++;
+          input->pending = true;
+        }
+        if (!ready (step)) break;
+        merged.write (step, no_deletions);
+        bits.set (step.id);
+        input->pending = false;
+        input->merged++;
+        stats.merged++;
+        progress = true;
+        if (step.lits.empty ()) empty = step.id;
+      }
+    }
+    if (progress) continue;
+    if (empty) break;
+    for (auto & input : inputs)
+      if (input->pending)
+        die ("%s: antecedent %" PRId64 " of clause %" PRId64
+          " not found in any proof",
+          input->reader.name (), missing (input->step), input->step.id);
+    die ("none of the proofs derives the empty clause");
+  }
+  for (auto & input : inputs)
+    if (!input->done) input->reader.close ();
+  msg ("merged %" PRId64 " clauses until empty clause %" PRId64,
+    stats.merged, empty);
+  stats.bits = bits.bytes ();
+}
+
+// Traverse merged steps backward starting with the empty clause.  The first
+// occurrence of an antecedent in this traversal is its last use in the
+// merged proof, after which it can be deleted.
+
+void LratMerge::prune () {
+  bits.clear ();
+  bits.set (empty);
+  pruned.open (tmp);
+  merged.rewind ();
+  LratStep step;
+  vector<int64_t> unused, last_uses;
+  while (merged.read_backward (step, unused)) {
+    if (!bits[step.id]) { stats.pruned++; continue; }
+    last_uses.clear ();
+    for (const auto & hint : step.hints) {
+      const int64_t id = abs (hint);
+      if (bits[id]) continue;
+      bits.set (id);
+      if (deletions) last_uses.push_back (id);
+    }
+    stats.deleted += last_uses.size ();
+    pruned.write (step, last_uses);
+  }
+  msg ("pruned %" PRId64 " unused clauses (%.0f%%)",
+    stats.pruned, percent (stats.pruned, stats.merged));
+  if (bits.bytes () > stats.bits) stats.bits = bits.bytes ();
+  bits.clear ();
+}
+
+void LratMerge::write () {
+  Output output (output_path);
+  pruned.rewind ();
+  LratStep step;
+  vector<int64_t> last_uses;
+  int64_t last_id = 0;
+  while (pruned.read_backward (step, last_uses)) {
+    if (delta_output) {
+      output.put ('a');
+      output.put_binary_signed (step.id - last_id);
+      for (const auto & lit : step.lits) output.put_binary_signed (lit);
+      output.put_binary_unsigned (0);
+      for (const auto & hint : step.hints)
+        output.put_binary_delta (step.id, hint);
+      output.put_binary_unsigned (0);
+    } else if (binary_output) {
+      output.put ('a');
+      output.put_binary_signed (step.id);
+      for (const auto & lit : step.lits) output.put_binary_signed (lit);
+      output.put_binary_unsigned (0);
+      for (const auto & hint : step.hints) output.put_binary_signed (hint);
+      output.put_binary_unsigned (0);
+    } else {
+      output.put (step.id), output.put (' ');
+      for (const auto & lit : step.lits)
+        output.put ((int64_t) lit), output.put (' ');
+      output.put ('0'), output.put (' ');
+      for (const auto & hint : step.hints)
+        output.put (hint), output.put (' ');
+      output.put ('0'), output.put ('\n');
+    }
+    stats.written++;
+    last_id = step.id;
+    if (last_uses.empty ()) continue;
+    if (delta_output) {
+      output.put ('d');
+      for (const auto & id : last_uses)
+        output.put_binary_delta (last_id + 1, id);
+      output.put_binary_unsigned (0);
+    } else if (binary_output) {
+      output.put ('d');
+      for (const auto & id : last_uses) output.put_binary_signed (id);
+      output.put_binary_unsigned (0);
+    } else {
+      output.put (step.id), output.put (' '), output.put ('d');
+      for (const auto & id : last_uses) output.put (' '), output.put (id);
+      output.put (' '), output.put ('0'), output.put ('\n');
+    }
+  }
+  output.close ();
+  msg ("wrote %" PRId64 " clauses and %" PRId64 " deletions to '%s'",
+    stats.written, stats.deleted, output.name ());
+}
+
+/*------------------------------------------------------------------------*/
+
+int LratMerge::main (int argc, char ** argv) {
+  const char * dimacs_path = 0;
+  vector<const char *> proof_paths;
+  for (int i = 1; i < argc; i++) {
+    const char * arg = argv[i];
+    if (!strcmp (arg, "-h") || !strcmp (arg, "--help")) {
+      fputs (USAGE, stdout);
+      return 0;
+    } else if (!strcmp (arg, "--version")) {
+      printf ("%s\n", version ());
+      return 0;
+    } else if (!strcmp (arg, "-q") || !strcmp (arg, "--quiet"))
+      quiet = true;
+    else if (!strcmp (arg, "--binary")) binary = true;
+    else if (!strcmp (arg, "--delta")) binary = delta = true;
+    else if (!strcmp (arg, "--frat")) frat = true;
+    else if (!strcmp (arg, "--binary-output")) binary_output = true;
+    else if (!strcmp (arg, "--delta-output"))
+      binary_output = delta_output = true;
+    else if (!strcmp (arg, "--no-deletions")) deletions = false;
+    else if (!strncmp (arg, "--tmp=", 6)) tmp = arg + 6;
+    else if (!strcmp (arg, "-o")) {
+      if (++i == argc) die ("argument to '-o' missing");
+      if (output_path) die ("multiple '-o' options");
+      output_path = argv[i];
+    } else if (arg[0] == '-' && arg[1])
+      die ("invalid option '%s' (try '-h')", arg);
+    else if (!dimacs_path) dimacs_path = arg;
+    else proof_paths.push_back (arg);
+  }
+  if (!dimacs_path) die ("no DIMACS file specified (try '-h')");
+  if (proof_paths.empty ()) die ("no proof specified (try '-h')");
+  if (!tmp && !(tmp = getenv ("TMPDIR"))) tmp = "/tmp";
+  if (output_path && !strcmp (output_path, "-")) output_path = 0;
+  if (!output_path) messages = stderr;
+
+  msg ("LratMerge Proof Merger for CaDiCaL Version %s", version ());
+  original = read_dimacs_clauses (dimacs_path);
+  if (original < 0) die ("can not read header of '%s'", dimacs_path);
+  msg ("found %" PRId64 " original clauses in '%s'", original, dimacs_path);
+  for (const auto & path : proof_paths) {
+    MergeInput * input = new MergeInput ();
+    inputs.push_back (input);
+    if (!input->reader.open (path, binary, frat, delta))
+      die ("can not read '%s'", path);
+  }
+
+  merge ();
+  prune ();
+  write ();
+
+  msg ("temporary files of %.0f MB and %.0f MB",
+    merged.bytes () / (double) (1 << 20),
+    pruned.bytes () / (double) (1 << 20));
+  msg ("clause bits of %.0f MB and maximum resident set size of %.0f MB",
+    stats.bits / (double) (1 << 20),
+    maximum_resident_set_size () / (double) (1 << 20));
+  msg ("total process time of %.2f seconds", absolute_process_time ());
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+}
+
+int main (int argc, char ** argv) {
+  CaDiCaL::LratMerge merge;
+  return merge.main (argc, argv);
+}
@@ -0,0 +1,403 @@
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#include "lratreader.hpp"
+#include "util.hpp"
+
+#include <cctype>
+#include <climits>
+#include <cstdarg>
+#include <cstring>
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Same in-process decompression and external decompression utilities as
+// in 'File::read' but without signature checks, since there is no
+// 'Internal' to report failures.
+
+static const char * const pipes[][2] = {
+  { ".xz", "xz -c -d %s" },
+  { ".lzma", "lzma -c -d %s" },
+  { ".bz2", "bzip2 -c -d %s" },
+  { ".gz", "gzip -c -d %s" },
+  { ".7z", "7z x -so %s 2>/dev/null" },
+};
+
+static bool compressed (const char * path) {
+  for (const auto & p : pipes)
+    if (has_suffix (path, p[0])) return true;
+  return false;
+}
+
+static FILE * open_input (const char * path, int & close_file) {
+  if (!strcmp (path, "-")) { close_file = 0; return stdin; }
+  if (!File::exists (path)) return 0;
+  FILE * res = File::decompress (path);
+  if (res) { close_file = 1; return res; }
+  for (const auto & p : pipes) {
+    if (!has_suffix (path, p[0])) continue;
+    const char * fmt = p[1];
+    char prg[8];
+    size_t len = strchr (fmt, ' ') - fmt;
+    strncpy (prg, fmt, len), prg[len] = 0;
+    char * found = File::find (prg);
+    if (!found) break;
+    delete [] found;
+    char * cmd = new char [strlen (fmt) + strlen (path)];
+    sprintf (cmd, fmt, path);
+    res = popen (cmd, "r");
+    delete [] cmd;
+    close_file = 2;
+    return res;
+  }
+  close_file = 1;
+  return fopen (path, "r");
+}
+
+static void close_input (FILE * file, int close_file) {
+  if (close_file == 1) fclose (file);
+  if (close_file == 2) pclose (file);
+}
+
+/*------------------------------------------------------------------------*/
+
+LratReader::LratReader () :
+  file (0), close_file (0), map (0), cursor (0), limit (0), mapped (0),
+  binary (false), frat (false), delta (false), last_id (0),
+  lineno (1), bytes (0)
+{
+}
+
+LratReader::~LratReader () { if (file || map) close (); }
+
+// Proofs are read only once from start to end, which allows the kernel to
+// drop pages already read ('MADV_SEQUENTIAL').  Empty files can not be
+// mapped and are read as ordinary files.
+
+bool LratReader::map_file (const char * p) {
+  int fd = ::open (p, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat buf;
+  void * res = MAP_FAILED;
+  if (!fstat (fd, &buf) && S_ISREG (buf.st_mode) && buf.st_size > 0)
+    res = mmap (0, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close (fd);
+  if (res == MAP_FAILED) return false;
+  madvise (res, buf.st_size, MADV_SEQUENTIAL);
+  map = cursor = (const unsigned char *) res;
+  mapped = buf.st_size;
+  limit = map + mapped;
+  return true;
+}
+
+bool LratReader::open (const char * p, bool b, bool f, bool d) {
+  assert (!file), assert (!map);
+  if (!strcmp (p, "-") || compressed (p) || !map_file (p)) {
+    file = open_input (p, close_file);
+    if (!file) return false;
+  }
+  path = strcmp (p, "-") ? p : "<stdin>";
+  binary = b, frat = f, delta = d && b && !f;
+  last_id = 0, lineno = 1, bytes = 0;
+  return true;
+}
+
+void LratReader::close () {
+  assert (file || map);
+  if (map) munmap ((void *) map, mapped), map = 0;
+  else close_input (file, close_file), file = 0;
+}
+
+LratStep::Type LratReader::error (const char * fmt, ...) {
+  char buffer[256];
+  va_list ap;
+  va_start (ap, fmt);
+  vsnprintf (buffer, sizeof buffer, fmt, ap);
+  va_end (ap);
+  char prefix[64];
+  if (binary) sprintf (prefix, ":%" PRIu64 ": ", bytes);
+  else sprintf (prefix, ":%" PRIu64 ": ", lineno);
+  message = path + prefix + buffer;
+  return LratStep::ERROR;
+}
+
+/*------------------------------------------------------------------------*/
+
+int LratReader::skip_spaces () {
+  int ch;
+  do ch = get ();
+  while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r');
+  return ch;
+}
+
+bool LratReader::read_number (int ch, int64_t & res) {
+  bool negative = (ch == '-');
+  if (negative) ch = get ();
+  if (!isdigit (ch)) return false;
+  uint64_t n = ch - '0';
+  while (isdigit (ch = get ())) {
+    if (n > (uint64_t) (INT64_MAX - 9) / 10) return false;
+    n = 10 * n + (ch - '0');
+  }
+  if (ch != EOF && ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r')
+    return false;
+  res = negative ? - (int64_t) n : (int64_t) n;
+  return true;
+}
+
+LratStep::Type LratReader::read_ascii_lits (LratStep & step) {
+  for (;;) {
+    int64_t lit;
+    if (!read_number (skip_spaces (), lit))
+      return error ("expected literal");
+    if (!lit) return LratStep::ADD;
+    if (lit <= INT_MIN || lit > INT_MAX)
+      return error ("invalid literal %" PRId64, lit);
+    step.lits.push_back ((int) lit);
+  }
+}
+
+LratStep::Type LratReader::read_ascii_ids (std::vector<int64_t> & ids) {
+  for (;;) {
+    int64_t id;
+    if (!read_number (skip_spaces (), id))
+      return error ("expected clause identifier");
+    if (!id) return LratStep::ADD;
+    ids.push_back (id);
+  }
+}
+
+// LRAT:  '<id> <lit> ... 0 <hint> ... 0' or '<id> d <id> ... 0'
+//
+// FRAT:  'a <id> <lit> ... 0 l <hint> ... 0', 'o <id> <lit> ... 0',
+//        'd <id> <lit> ... 0', 'f <id> <lit> ... 0' or 't ... 0'
+
+LratStep::Type LratReader::read_ascii (LratStep & step) {
+  for (;;) {
+    int ch = skip_spaces ();
+    if (ch == EOF) return LratStep::END;
+    if (ch == 'c') {
+      while ((ch = get ()) != '\n')
+        if (ch == EOF) return LratStep::END;
+      continue;
+    }
+    step.lits.clear ();
+    step.hints.clear ();
+    if (frat) {
+      if (ch == 't') {
+        if (read_ascii_ids (step.hints) == LratStep::ERROR)
+          return LratStep::ERROR;
+        continue;
+      }
+      if (ch != 'a' && ch != 'o' && ch != 'd' && ch != 'f')
+        return error ("unexpected character '%c'", ch);
+      if (!read_number (skip_spaces (), step.id) || step.id <= 0)
+        return error ("expected clause identifier");
+      if (read_ascii_lits (step) == LratStep::ERROR)
+        return LratStep::ERROR;
+      if (ch == 'o') return step.type = LratStep::ORIGINAL;
+      if (ch == 'f') continue;
+      if (ch == 'd') {
+        step.hints.push_back (step.id);
+        return step.type = LratStep::DELETE;
+      }
+      if ((ch = skip_spaces ()) != 'l')
+        return error ("derived clause %" PRId64 " without hints", step.id);
+      if (read_ascii_ids (step.hints) == LratStep::ERROR)
+        return LratStep::ERROR;
+      return step.type = LratStep::ADD;
+    }
+    if (!read_number (ch, step.id) || step.id <= 0)
+      return error ("expected clause identifier");
+    ch = skip_spaces ();
+    if (ch == 'd') {
+      if (read_ascii_ids (step.hints) == LratStep::ERROR)
+        return LratStep::ERROR;
+      return step.type = LratStep::DELETE;
+    }
+    unget (ch);
+    if (read_ascii_lits (step) == LratStep::ERROR ||
+        read_ascii_ids (step.hints) == LratStep::ERROR)
+      return LratStep::ERROR;
+    return step.type = LratStep::ADD;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+bool LratReader::read_unsigned (uint64_t & res) {
+  res = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    int ch = get ();
+    if (ch == EOF) return false;
+    res |= (uint64_t) (ch & 0x7f) << shift;
+    if (!(ch & 0x80)) return true;
+  }
+  return false;
+}
+
+bool LratReader::read_signed (int64_t & res) {
+  uint64_t u;
+  if (!read_unsigned (u)) return false;
+  res = (u & 1) ? - (int64_t) (u >> 1) : (int64_t) (u >> 1);
+  return true;
+}
+
+LratStep::Type LratReader::read_binary_lits (LratStep & step) {
+  for (;;) {
+    int64_t lit;
+    if (!read_signed (lit)) return error ("expected literal");
+    if (!lit) return LratStep::ADD;
+    if (lit <= INT_MIN || lit > INT_MAX)
+      return error ("invalid literal %" PRId64, lit);
+    step.lits.push_back ((int) lit);
+  }
+}
+
+LratStep::Type LratReader::read_binary_ids (std::vector<int64_t> & ids) {
+  for (;;) {
+    int64_t id;
+    if (!read_signed (id)) return error ("expected clause identifier");
+    if (!id) return LratStep::ADD;
+    ids.push_back (id);
+  }
+}
+
+// Identifiers are encoded signed in binary LRAT but unsigned in FRAT.  In
+// delta encoded binary LRAT the identifier of a derived clause is relative
+// to the previous derived clause, while hints and deleted identifiers are
+// absolute or relative to a base as explained in 'tracer.cpp'.
+
+static int64_t undelta (int64_t base, int64_t v) {
+  const int64_t m = v < 0 ? -v : v;
+  const int64_t id = (m & 1) ? base - (m >> 1) : (m >> 1);
+  return v < 0 ? -id : id;
+}
+
+LratStep::Type LratReader::read_binary (LratStep & step) {
+  for (;;) {
+    int ch = get ();
+    if (ch == EOF) return LratStep::END;
+    step.lits.clear ();
+    step.hints.clear ();
+    if (frat && ch == 't') {
+      uint64_t val;
+      do if (!read_unsigned (val)) return error ("expected number");
+      while (val);
+      continue;
+    }
+    if (!frat && ch == 'd') {
+      if (read_binary_ids (step.hints) == LratStep::ERROR)
+        return LratStep::ERROR;
+      if (delta)
+        for (auto & id : step.hints)
+          if ((id = undelta (last_id + 1, id)) <= 0)
+            return error ("invalid deleted clause identifier");
+      return step.type = LratStep::DELETE;
+    }
+    if (ch != 'a' && (!frat || (ch != 'o' && ch != 'd' && ch != 'f')))
+      return error ("unexpected byte 0x%02x", ch);
+    if (frat) {
+      uint64_t id;
+      if (!read_unsigned (id) || !id || id > INT64_MAX)
+        return error ("expected clause identifier");
+      step.id = id;
+    } else if (!read_signed (step.id) ||
+               (delta && (step.id += last_id) <= 0) || step.id <= 0)
+      return error ("expected clause identifier");
+    if (read_binary_lits (step) == LratStep::ERROR)
+      return LratStep::ERROR;
+    if (ch == 'o') return step.type = LratStep::ORIGINAL;
+    if (ch == 'f') continue;
+    if (ch == 'd') {
+      step.hints.push_back (step.id);
+      return step.type = LratStep::DELETE;
+    }
+    if (frat && get () != 'l')
+      return error ("derived clause %" PRId64 " without hints", step.id);
+    if (read_binary_ids (step.hints) == LratStep::ERROR)
+      return LratStep::ERROR;
+    if (delta) {
+      // Hints can refer to clauses with larger identifiers, which were
+      // derived by other instances and imported (thus no bounds here).
+      for (auto & hint : step.hints) {
+        const int64_t id = undelta (step.id, hint);
+        if (!id)
+          return error ("invalid hint in clause %" PRId64, step.id);
+        hint = id;
+      }
+      last_id = step.id;
+    }
+    return step.type = LratStep::ADD;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+LratStep::Type LratReader::next (LratStep & step, bool deletions) {
+  assert (file || map);
+  for (;;) {
+    LratStep::Type res = binary ? read_binary (step) : read_ascii (step);
+    if (res != LratStep::DELETE || deletions) return res;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+int64_t read_dimacs_clauses (const char * path) {
+  int close_file;
+  FILE * file = open_input (path, close_file);
+  if (!file) return -1;
+  int64_t vars = -1, clauses = -1;
+  int ch;
+  while ((ch = cadical_getc_unlocked (file)) == 'c')
+    while ((ch = cadical_getc_unlocked (file)) != '\n' && ch != EOF)
+      ;
+  if (ch == 'p' &&
+      fscanf (file, " cnf %" SCNd64 " %" SCNd64, &vars, &clauses) != 2)
+    clauses = -1;
+  close_input (file, close_file);
+  return clauses;
+}
+
+int64_t read_dimacs (const char * path, std::vector<int> & literals) {
+  int close_file;
+  FILE * file = open_input (path, close_file);
+  if (!file) return -1;
+  int64_t vars = -1, clauses = -1, parsed = 0;
+  int ch;
+  while ((ch = cadical_getc_unlocked (file)) == 'c')
+    while ((ch = cadical_getc_unlocked (file)) != '\n' && ch != EOF)
+      ;
+  if (ch != 'p' ||
+      fscanf (file, " cnf %" SCNd64 " %" SCNd64, &vars, &clauses) != 2 ||
+      vars < 0 || vars > INT_MAX || clauses < 0)
+    clauses = -1;
+  int64_t lit;
+  while (clauses >= 0) {
+    if (fscanf (file, " %" SCNd64, &lit) == 1) {
+      if (lit < -vars || lit > vars) clauses = -1;
+      else if (!lit) parsed++;
+      literals.push_back ((int) lit);
+    } else if ((ch = cadical_getc_unlocked (file)) == 'c') {
+      while ((ch = cadical_getc_unlocked (file)) != '\n' && ch != EOF)
+        ;
+    } else if (ch != EOF || parsed != clauses ||
+               (!literals.empty () && literals.back ()))
+      clauses = -1;
+    else break;
+  }
+  close_input (file, close_file);
+  return clauses;
+}
+
+}
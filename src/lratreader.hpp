@@ -0,0 +1,131 @@
+#ifndef _lratreader_hpp_INCLUDED
+#define _lratreader_hpp_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "file.hpp"     // For 'cadical_getc_unlocked'.
+
+namespace CaDiCaL {
+
+// Streaming reader for the clausal proofs written by 'Tracer' in LRAT or
+// FRAT format, either in ASCII or in binary encoding.  It is used by the
+// stand alone proof tools and thus does not depend on 'Internal'.  Proofs
+// are read step by step and never kept in memory.  Uncompressed proof
+// files are memory mapped, while compressed proofs are read through a pipe
+// to an external decompression utility (see 'File').
+
+struct LratStep {
+
+  enum Type {
+    END = 0,            // no more steps
+    ORIGINAL = 1,       // original clause (FRAT only)
+    ADD = 2,            // derived clause with hints in 'hints'
+    DELETE = 3,         // deleted clauses (their identifiers in 'hints')
+    ERROR = 4,          // parse error (see 'LratReader::error')
+  };
+
+  Type type;
+  int64_t id;                   // identifier of added clause
+  std::vector<int> lits;        // literals of added clause
+  std::vector<int64_t> hints;   // antecedents or deleted identifiers
+};
+
+class LratReader {
+
+  FILE * file;
+  int close_file;               // need to close file (1=fclose, 2=pclose)
+
+  const unsigned char * map;    // memory mapped file (if not zero)
+  const unsigned char * cursor, * limit;
+  size_t mapped;
+  std::string path;
+  bool binary, frat, delta;
+  int64_t last_id;              // last derived clause (for 'delta')
+  uint64_t lineno;
+  uint64_t bytes;
+  std::string message;          // last parse error
+
+  int get () {
+    int res;
+    if (map) res = cursor < limit ? *cursor++ : EOF;
+    else res = cadical_getc_unlocked (file);
+    if (res == '\n') lineno++;
+    if (res != EOF) bytes++;
+    return res;
+  }
+
+  void unget (int ch) {
+    assert (ch != '\n');
+    if (ch == EOF) return;
+    if (map) cursor--;
+    else ungetc (ch, file);
+    bytes--;
+  }
+
+  bool map_file (const char * path);
+
+  LratStep::Type error (const char * fmt, ...);
+
+  // ASCII format.
+  //
+  int skip_spaces ();
+  bool read_number (int ch, int64_t & res);
+  LratStep::Type read_ascii_lits (LratStep &);
+  LratStep::Type read_ascii_ids (std::vector<int64_t> &);
+  LratStep::Type read_ascii (LratStep &);
+
+  // Binary format (as 'Tracer::put_binary_unsigned' and
+  // 'Tracer::put_binary_signed', with 'delta' as 'Tracer' with option
+  // 'lratdelta').
+  //
+  bool read_unsigned (uint64_t & res);
+  bool read_signed (int64_t & res);
+  LratStep::Type read_binary_lits (LratStep &);
+  LratStep::Type read_binary_ids (std::vector<int64_t> &);
+  LratStep::Type read_binary (LratStep &);
+
+  LratReader (const LratReader &);      // Not copyable.
+  LratReader & operator= (const LratReader &);
+
+public:
+
+  LratReader ();
+  ~LratReader ();
+
+  // Open the proof ('-' for '<stdin>').  Returns 'false' if the file can
+  // not be opened.  By default the proof is expected in LRAT format.
+  // Binary LRAT proofs can have delta encoded identifiers ('delta').
+  //
+  bool open (const char * path, bool binary, bool frat,
+             bool delta = false);
+  void close ();
+
+  bool memory_mapped () const { return map; }
+
+  // Read the next step.  Deletions, finalized clauses and other FRAT steps
+  // which are not needed to check or merge proofs are skipped.  With
+  // 'deletions' set deleted clauses are returned as 'DELETE' steps though.
+  //
+  LratStep::Type next (LratStep &, bool deletions = false);
+
+  const char * name () const { return path.c_str (); }
+  const char * error () const { return message.c_str (); }
+  uint64_t read_bytes () const { return bytes; }
+};
+
+// Read the number of clauses in the header of a DIMACS file.  These are the
+// identifiers of original clauses in LRAT proofs.  Returns '-1' on errors.
+
+int64_t read_dimacs_clauses (const char * path);
+
+// Read all clauses of a DIMACS file and append their literals, each clause
+// terminated by zero, to 'literals'.  Returns the number of clauses
+// (checked against the header) or '-1' on errors.
+
+int64_t read_dimacs (const char * path, std::vector<int> & literals);
+
+}
+
+#endif
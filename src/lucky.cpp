@@ -46,6 +46,19 @@ int Internal::trivially_false_satisfiable () {
     LOG (c, "found purely positively");
     return unlucky (0);
   }
+  for (auto lit : lits) {
+    if (terminated_asynchronously (100)) return unlucky (-1);
+    const signed char tmp = val (lit);
+    if (tmp > 0 || (!tmp && lit < 0)) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (w.redundant) continue;
+      const int other = w.blit;
+      const signed char u = val (other);
+      if (u > 0 || (!u && other < 0)) continue;
+      LOG ("found purely positively binary clause %d %d", lit, other);
+      return unlucky (0);
+    }
+  }
   VERBOSE (1, "all clauses contain a negative literal");
   for (auto idx : vars) {
     if (terminated_asynchronously (10)) return unlucky (-1);
@@ -81,6 +94,19 @@ int Internal::trivially_true_satisfiable () {
     LOG (c, "found purely negatively");
     return unlucky (0);
   }
+  for (auto lit : lits) {
+    if (terminated_asynchronously (100)) return unlucky (-1);
+    const signed char tmp = val (lit);
+    if (tmp > 0 || (!tmp && lit > 0)) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (w.redundant) continue;
+      const int other = w.blit;
+      const signed char u = val (other);
+      if (u > 0 || (!u && other > 0)) continue;
+      LOG ("found purely negatively binary clause %d %d", lit, other);
+      return unlucky (0);
+    }
+  }
   VERBOSE (1, "all clauses contain a positive literal");
   for (auto idx : vars) {
     if (terminated_asynchronously (10)) return unlucky (-1);
@@ -27,12 +27,16 @@ bool Internal::minimize_literal (int lit, int depth) {
   if (depth > opts.minimizedepth) return false;
   bool res = true;
   assert (v.reason);
-  const const_literal_iterator end = v.reason->end ();
-  const_literal_iterator i;
-  for (i = v.reason->begin (); res && i != end; i++) {
-    const int other = *i;
-    if (other == lit) continue;
-    res = minimize_literal (-other, depth + 1);
+  if (is_binary_reason (v.reason))
+    res = minimize_literal (-binary_reason_literal (v.reason), depth + 1);
+  else {
+    const const_literal_iterator end = v.reason->end ();
+    const_literal_iterator i;
+    for (i = v.reason->begin (); res && i != end; i++) {
+      const int other = *i;
+      if (other == lit) continue;
+      res = minimize_literal (-other, depth + 1);
+    }
   }
   if (res) f.removable = true; else f.poison = true;
   minimized.push_back (lit);
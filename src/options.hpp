@@ -41,6 +41,9 @@ OPTION( chrono,            1,  0,  2,0,0,1, "chronological backtracking") \
 OPTION( chronoalways,      0,  0,  1,0,0,1, "force always chronological") \
 OPTION( chronolevelim,   1e2,  0,2e9,0,0,1, "chronological level limit") \
 OPTION( chronoreusetrail,  1,  0,  1,0,0,1, "reuse trail chronologically") \
+OPTION( collectinc,        0,  0,  1,0,0,1, "incremental garbage collection") \
+OPTION( collectincbytes,6.4e7,1e3,2e9,0,0,1, "bytes per incremental collection") \
+OPTION( collectthreads,    1,  1, 64,0,0,1, "garbage collection threads") \
 OPTION( compact,           0,  0,  1,0,1,1, "compact internal variables") \
 OPTION( compactint,      2e3,  1,2e9,0,0,1, "compacting interval") \
 OPTION( compactlim,      1e2,  0,1e3,0,0,1, "inactive limit in per mille") \
@@ -80,6 +83,7 @@ OPTION( elimreleff,      1e3,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( elimrounds,        2,  1,512,1,0,1, "usual number of rounds") \
 OPTION( elimsubst,         1,  0,  1,0,0,1, "elimination by substitution") \
 OPTION( elimsum,           1,  0,1e4,0,0,1, "elimination score sum weight") \
+OPTION( elimthreads,       1,  1, 64,0,0,1, "elimination checking threads") \
 OPTION( elimxorlim,        5,  2, 27,1,0,1, "maximum XOR size") \
 OPTION( elimxors,          1,  0,  1,0,0,1, "find XOR gates") \
 OPTION( emagluefast,      33,  1,2e9,0,0,1, "window fast glue") \
@@ -94,6 +98,13 @@ OPTION( flushfactor,       3,  1,1e3,0,0,1, "interval increase") \
 OPTION( flushint,        1e5,  1,2e9,0,0,1, "initial limit") \
 OPTION( forcephase,        0,  0,  1,0,0,1, "always use initial phase") \
 OPTION( frat,              0,  0,  1,0,0,0, "output proof in FRAT format") \
+OPTION( idblock,           1,  1,2e9,0,0,0, "clause ids reserved per block") \
+OPTION( importglue,        0,  0,2e9,0,0,1, "maximum imported glue (0=unlimited)") \
+OPTION( importhash,       16,  0, 30,0,0,1, "log2 duplicate import filter size (0=off)") \
+OPTION( importlevels,      1,  0,  1,0,0,1, "import at non-zero decision levels") \
+OPTION( importlim,         0,  0,2e9,0,0,1, "clauses imported per round (0=all)") \
+OPTION( importqueue,     1e5,  0,2e9,0,0,1, "maximum deferred imported clauses") \
+OPTION( importsize,        0,  0,2e9,0,0,1, "maximum imported size (0=unlimited)") \
 OPTION( inprocessing,      1,  0,  1,0,0,1, "enable inprocessing")      \
 OPTION( instance_num,      1,  1,2e9,0,0,0, "instance number of multiple instances running") \
 OPTION( instantiate,       0,  0,  1,0,1,1, "variable instantiation") \
@@ -103,11 +114,13 @@ OPTION( instantiateonce,   1,  0,  1,0,0,1, "instantiate each clause once") \
 LOGOPT( log,               0,  0,  1,0,0,0, "enable logging") \
 LOGOPT( logsort,           0,  0,  1,0,0,0, "sort logged clauses") \
 OPTION( lrat,              1,  0,  1,0,0,0, "use (approximate) LRAT proof format") \
+OPTION( lratdelta,         0,  0,  1,0,0,0, "delta encode binary LRAT identifiers") \
 OPTION( lucky,             1,  0,  1,0,0,1, "search for lucky phases")  \
 OPTION( minimize,          1,  0,  1,0,0,1, "minimize learned clauses") \
 OPTION( minimizedepth,   1e3,  0,1e3,0,0,1, "minimization depth") \
 OPTION( num_original_clauses,0,0,2e9,0,0,1, "number of clauses in the problem") \
 OPTION( phase,             1,  0,  1,0,0,1, "initial phase") \
+OPTION( prefetch,          0,  0, 64,0,0,1, "prefetch clauses ahead in watches") \
 OPTION( probe,             1,  0,  1,0,1,1, "failed literal probing" ) /* FIX: 0 */ \
 OPTION( probehbr,          1,  0,  1,0,0,1, "learn hyper binary clauses") \
 OPTION( probeint,        5e3,  1,2e9,0,0,1, "probing interval" ) \
@@ -116,6 +129,7 @@ OPTION( probemineff,     1e6,  0,2e9,1,0,1, "minimum probing efficiency") \
 OPTION( probereleff,      20,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( proberounds,       1,  1, 16,1,0,1, "probing rounds" ) \
 OPTION( profile,           2,  0,  4,0,0,0, "profiling level") \
+OPTION( proofasync,        0,  0,  1,0,0,0, "write proof in background thread") \
 OPTION( proofdelete,       1,  0,  1,0,0,0, "add delete clauses to written proof") \
 QUTOPT( quiet,             0,  0,  1,0,0,0, "disable all messages")     \
 OPTION( radixsortlim,    800,  0,2e9,0,0,1, "radix sort limit") \
@@ -149,6 +163,7 @@ OPTION( shufflequeue,      1,  0,  1,0,0,1, "shuffle variable queue") \
 OPTION( shufflerandom,     0,  0,  1,0,0,1, "not reverse but random") \
 OPTION( shufflescores,     1,  0,  1,0,0,1, "shuffle variable scores") \
 OPTION( simplify,          1,  0,  1,0,0,0, "enable simplifier") \
+OPTION( slab,              0,  0,  1,0,0,1, "allocate clauses in slabs") \
 OPTION( stabilize,         1,  0,  1,0,0,1, "enable stabilizing phases") \
 OPTION( stabilizefactor, 200,101,2e9,0,0,1, "phase increase in percent") \
 OPTION( stabilizeint,    1e3,  1,2e9,0,0,1, "stabilizing interval") \
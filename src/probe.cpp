@@ -97,20 +97,21 @@ int Internal::probe_dominator (int a, int b) {
 // do not change clauses in (A).
 
 // The hyper binary resolvent clause is redundant unless it subsumes the
-// original reason and that one is irredundant.
+// original reason and that one is irredundant.  It replaces 'reason' as
+// reason of the new unit and its LRAT chain follows the implication tree
+// from the dominator to the falsified literals of 'reason'.
 
 // If the option 'opts.probehbr' is 'false', we actually do not add the new
 // hyper binary resolvent, but simply pretend we would have added it and
 // still return the dominator as new reason / parent for the new unit.
 
-// Finally note that adding clauses changes the watches of the propagated
-// literal and thus we can not use standard iterators during probing but
-// need to fall back to indices.  One watch for the hyper binary resolvent
-// clause is added at the end of the currently propagated watches, but its
-// watch is a binary watch and will be skipped during propagating long
-// clauses anyhow.
+// The hyper binary resolvent is only added to the binary watches and thus
+// does not change the large watches of the propagated literal.  If it is
+// added, 'reason' is updated to the binary reason of the new unit and its
+// identifier is returned in 'id'.
 
-inline int Internal::hyper_binary_resolve (Clause * reason) {
+inline int
+Internal::hyper_binary_resolve (Clause * & reason, clause_id_t & id) {
   require_mode (PROBE);
   assert (level == 1);
   assert (reason->size > 2);
@@ -146,15 +147,15 @@ inline int Internal::hyper_binary_resolve (Clause * reason) {
     assert (clause.empty ());
     clause.push_back (-dom);
     clause.push_back (lits[0]);
-    PROOF_TODO (proof, "hyper binary resolution", 70); // TODO(Mario)
-    Clause * c = new_hyper_binary_resolved_clause (red, 2);
-    if (red) c->hyper = true;
+    build_chain (clause, reason);
+    id = new_hyper_binary_resolved_clause (red);
     clause.clear ();
     if (contained) {
       stats.hbrsubs++;
       LOG (reason, "subsumed original");
       mark_garbage (reason);
     }
+    reason = binary_reason (-dom);
   }
   return dom;
 }
@@ -169,7 +170,8 @@ inline int Internal::hyper_binary_resolve (Clause * reason) {
 // The code is mostly copied from 'propagate.cpp' and specialized.  We only
 // comment on the differences.  More explanations are in 'propagate.cpp'.
 
-inline void Internal::probe_assign (int lit, int parent) {
+inline void
+Internal::probe_assign (int lit, int parent, Clause * reason, clause_id_t id) {
   require_mode (PROBE);
   int idx = vidx (lit);
   assert (!vals[idx]);
@@ -178,12 +180,15 @@ inline void Internal::probe_assign (int lit, int parent) {
   Var & v = var (idx);
   v.level = level;
   v.trail = (int) trail.size ();
+  v.reason = level ? reason : 0;
   set_parent_reason_literal (lit, parent);
   if (!level) {
-    PROOF_TODO (proof, "probe assign", 71); // TODO(Mario)
+    if (reason) build_unit_chain (lit, reason_clause (lit, reason, id));
     learn_unit_clause (lit);
+  } else {
+    assert (level == 1);
+    v.binary_id = id;
   }
-  else assert (level == 1);
   const signed char tmp = sign (lit);
   vals[idx] = tmp;
   vals[-idx] = -tmp;
@@ -209,14 +214,14 @@ void Internal::probe_assign_decision (int lit) {
   assert (propagated == trail.size ());
   level++;
   control.push_back (Level (lit, trail.size ()));
-  probe_assign (lit, 0);
+  probe_assign (lit, 0, 0);
 }
 
-void Internal::probe_assign_unit (int lit) {
+void Internal::probe_assign_unit (int lit, Clause * reason) {
   require_mode (PROBE);
   assert (!level);
   assert (active (lit));
-  probe_assign (lit, 0);
+  probe_assign (lit, 0, reason);
 }
 
 /*------------------------------------------------------------------------*/
@@ -234,13 +239,14 @@ inline void Internal::probe_propagate2 () {
   while (propagated2 != trail.size ()) {
     const int lit = -trail[propagated2++];
     LOG ("probe propagating %d over binary clauses", -lit);
-    Watches & ws = watches (lit);
-    for (const auto & w : ws) {
-      if (!w.binary ()) continue;
+    for (const auto & w : binary_watches (lit)) {
       const signed char b = val (w.blit);
       if (b > 0) continue;
-      if (b < 0) conflict = w.clause;                   // but continue
-      else probe_assign (w.blit, -lit);
+      if (b < 0)                                          // but continue
+        conflict = binary_clause (&binary_conflict_clause,
+                                  lit, w.blit, binary_id (w), w.redundant);
+      else
+        probe_assign (w.blit, -lit, binary_reason (lit), binary_id (w));
     }
   }
 }
@@ -259,48 +265,49 @@ bool Internal::probe_propagate () {
       size_t i = 0, j = 0;
       while (i != ws.size ()) {
         const Watch w = ws[j++] = ws[i++];
-        if (w.binary ()) continue;
         const signed char b = val (w.blit);
         if (b > 0) continue;
-        if (w.clause->garbage) continue;
-        const literal_iterator lits = w.clause->begin ();
+        Clause * c = watched (w);
+        if (c->garbage) continue;
+        const literal_iterator lits = c->begin ();
         const int other = lits[0]^lits[1]^lit;
         //lits[0] = other, lits[1] = lit;
         const signed char u = val (other);
         if (u > 0) ws[j-1].blit = other;
         else {
-          const int size = w.clause->size;
+          const int size = c->size;
           const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
+          const literal_iterator middle = lits + c->pos;
           literal_iterator k = middle;
           int r = 0;
           signed char v = -1;
-          while (k != end && (v = val (r = *k)) < 0)
-            k++;
-          if (v < 0) {
-            k = lits + 2;
-            assert (w.clause->pos <= size);
-            while (k != middle && (v = val (r = *k)) < 0)
-              k++;
+          k = find_non_false (k, end);
+          if (k != end) v = val (r = *k);
+          else {
+            assert (c->pos <= size);
+            k = find_non_false (lits + 2, middle);
+            if (k != middle) v = val (r = *k);
           }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+          c->pos = k - lits;
+          assert (lits + 2 <= k), assert (k <= c->end ());
           if (v > 0) ws[j-1].blit = r;
           else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
+            LOG (c, "unwatch %d in", r);
             *k = lit;
             lits[0] = other;
             lits[1] = r;
-            watch_literal (r, lit, w.clause);
+            watch_literal (r, lit, c);
             j--;
           } else if (!u) {
             if (level == 1) {
               lits[0] = other, lits[1] = lit;
-              int dom = hyper_binary_resolve (w.clause);
-              probe_assign (other, dom);
-            } else probe_assign_unit (other);
+              Clause * reason = c;
+              clause_id_t id = 0;
+              int dom = hyper_binary_resolve (reason, id);
+              probe_assign (other, dom, reason, id);
+            } else probe_assign_unit (other, c);
             probe_propagate2 ();
-          } else conflict = w.clause;
+          } else conflict = c;
         }
       }
       if (j != i) {
@@ -354,15 +361,33 @@ void Internal::failed_literal (int failed) {
     work.push_back (parent);
   }
 
+  // For LRAT the chains of the new units have to be built before we
+  // backtrack, since they follow the reasons on decision level one from the
+  // conflict back to the respective failed parent.  The last one is the
+  // chain for the unit clause of the negated UIP.
+
+  vector<vector<clause_id_t>> chains;
+  if (proof && opts.lrat) {
+    vector<int> unit (1);
+    for (size_t i = 0; i <= work.size (); i++) {
+      unit[0] = -(i < work.size () ? work[i] : uip);
+      build_chain (unit, conflict);
+      chains.push_back (chain);
+      chain.clear ();
+    }
+  }
+
   backtrack ();
   clear_analyzed_literals ();
   conflict = 0;
 
   assert (!val (uip));
+  if (!chains.empty ()) chain.swap (chains.back ()), chains.pop_back ();
   probe_assign_unit (-uip);
 
   if (!probe_propagate ()) {
-        learn_empty_clause ();
+    build_chain ();
+    learn_empty_clause ();
   }
 
   while (!unsat && !work.empty ()) {
@@ -370,6 +395,11 @@ void Internal::failed_literal (int failed) {
     work.pop_back ();
     const signed char tmp = val (parent);
     if (tmp < 0) continue;
+    if (!chains.empty ()) {
+      assert (chain.empty ());
+      if (tmp > 0) chain.push_back (var (parent).unit_id);
+      for (const auto & id : chains[work.size ()]) chain.push_back (id);
+    }
     if (tmp > 0) {
       LOG ("clashing failed parent %d", parent);
       learn_empty_clause ();
@@ -377,6 +407,7 @@ void Internal::failed_literal (int failed) {
       LOG ("found unassigned failed parent %d", parent);
       probe_assign_unit (-parent);
       if (!probe_propagate ()) {
+        build_chain ();
         learn_empty_clause ();
       }
     }
@@ -435,6 +466,14 @@ void Internal::generate_probes () {
     noccs (a)++;
     noccs (b)++;
   }
+  for (auto lit : lits) {
+    if (val (lit)) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (lit > w.blit || val (w.blit)) continue;
+      noccs (lit)++;
+      noccs (w.blit)++;
+    }
+  }
 
   for (auto idx : vars) {
 
@@ -485,6 +524,14 @@ void Internal::flush_probes () {
     noccs (a)++;
     noccs (b)++;
   }
+  for (auto lit : lits) {
+    if (val (lit)) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (lit > w.blit || val (w.blit)) continue;
+      noccs (lit)++;
+      noccs (w.blit)++;
+    }
+  }
 
   const auto eop = probes.end ();
   auto j = probes.begin ();
@@ -611,8 +658,9 @@ bool Internal::probe_round () {
     LOG ("probing produced %zd units", (size_t)(trail.size () - propagated));
     if (!propagate ()) {
       LOG ("propagating units after probing results in empty clause");
+      build_chain ();
       learn_empty_clause ();
-    } else sort_watches ();
+    }
   }
 
   int failed = stats.failed - old_failed;
@@ -641,8 +689,10 @@ void CaDiCaL::Internal::probe (bool update_limits) {
 
   if (unsat) return;
   if (level) backtrack ();
-  if (!propagate ()) { 
-    learn_empty_clause (); return; 
+  if (!propagate ()) {
+    build_chain ();
+    learn_empty_clause ();
+    return;
   }
 
   stats.probingphases++;
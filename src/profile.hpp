@@ -40,6 +40,7 @@ struct Internal;
 #define PROFILES \
 PROFILE(analyze,3) \
 PROFILE(backward,3) \
+PROFILE(binaries,3) \
 PROFILE(block,2) \
 PROFILE(bump,4) \
 PROFILE(checking,2) \
@@ -20,7 +20,7 @@ void Internal::new_proof_on_demand () {
 void Internal::trace (File * file) {
   assert (!tracer);
   new_proof_on_demand ();
-  tracer = new Tracer (this, file, opts.binary, opts.lrat, opts.frat, opts.proofdelete);
+  tracer = new Tracer (this, file, opts.binary, opts.lrat, opts.frat, opts.proofdelete, opts.proofasync, opts.lratdelta);
   LOG ("PROOF connecting proof tracer");
   proof->connect_tracer(tracer);
 }
@@ -110,6 +110,14 @@ void Proof::add_derived_clause (clause_id_t id, const vector<int> & c, bool is_i
   add_derived_clause (id, is_imported, glue);
 }
 
+void Proof::add_derived_binary_clause (clause_id_t id, int a, int b, bool is_imported) {
+  LOG ("PROOF adding derived binary clause [%ld] %d %d", id, a, b);
+  assert (clause.empty ());
+  add_literal (a);
+  add_literal (b);
+  add_derived_clause (id, is_imported, 2);
+}
+
 void Proof::delete_clause (Clause * c) {
   LOG (c, "PROOF deleting from proof");
   assert (clause.empty ());
@@ -124,6 +132,14 @@ void Proof::delete_clause (clause_id_t id, const vector<int> & c) {
   delete_clause (id);
 }
 
+void Proof::delete_binary_clause (clause_id_t id, int a, int b) {
+  LOG ("PROOF deleting binary clause [%ld] %d %d", id, a, b);
+  assert (clause.empty ());
+  add_literal (a);
+  add_literal (b);
+  delete_clause (id);
+}
+
 void Proof::finalize_clause (Clause * c) {
   if (!internal->opts.lrat) return;
   LOG (c, "PROOF finalizing");
@@ -140,6 +156,15 @@ void Proof::finalize_clause (clause_id_t id, const vector<int> & c) {
   finalize_clause (id);
 }
 
+void Proof::finalize_binary_clause (clause_id_t id, int a, int b) {
+  if (!internal->opts.lrat) return;
+  LOG ("PROOF finalizing binary clause [%ld] %d %d", id, a, b);
+  assert (clause.empty ());
+  add_literal (a);
+  add_literal (b);
+  finalize_clause (id);
+}
+
 void Proof::finalize_clause_ext (clause_id_t id, const vector<int> & c) {
   clause = c;
   finalize_clause (id);
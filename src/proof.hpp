@@ -54,14 +54,17 @@ public:
   void add_derived_unit_clause (clause_id_t id, int unit, bool is_imported);
   void add_derived_clause (Clause *, bool); //bool is_imported
   void add_derived_clause (clause_id_t id, const vector<int> &, bool, int); //bool is_imported, int glue
+  void add_derived_binary_clause (clause_id_t, int, int, bool); //bool is_imported
 
   void delete_clause (clause_id_t, const vector<int> &);
   void delete_clause (Clause *);
+  void delete_binary_clause (clause_id_t, int, int);
 
   // notify observers of active clauses (deletion after empty clause)
   //
   void finalize_clause (clause_id_t, const vector<int> &);
   void finalize_clause (Clause *);
+  void finalize_binary_clause (clause_id_t, int, int);
   void finalize_clause_ext (clause_id_t, const vector<int> &);
 
   // These two actually pretend to add and remove a clause.
@@ -24,12 +24,15 @@ namespace CaDiCaL {
 // function determines this assignment level. For non-chronological
 // backtracking as in classical CDCL this function always returns the
 // current decision level, the concept of assignment level does not make
-// sense, and accordingly this function can be skipped.
+// sense, and accordingly this function can be skipped.  For binary reasons
+// it is the level of the other literal.
 
 inline int Internal::assignment_level (int lit, Clause * reason) {
 
   assert (opts.chrono);
   if (!reason) return level;
+  if (is_binary_reason (reason))
+    return var (binary_reason_literal (reason)).level;
 
   int res = 0;
 
@@ -45,7 +48,10 @@ inline int Internal::assignment_level (int lit, Clause * reason) {
 
 /*------------------------------------------------------------------------*/
 
-inline void Internal::search_assign (int lit, Clause * reason) {
+// The identifier 'id' is only used for binary reasons (see 'watch.hpp').
+
+inline void
+Internal::search_assign (int lit, Clause * reason, clause_id_t id) {
 
   if (level) require_mode (SEARCH);
 
@@ -63,7 +69,12 @@ inline void Internal::search_assign (int lit, Clause * reason) {
   else if (opts.chrono) lit_level = assignment_level (lit, reason);
   else lit_level = level;
   if (!lit_level) {
-    if (proof && chain.empty () && reason && reason != decision_reason) {
+    if (proof && chain.empty () && is_binary_reason (reason)) {
+      const int other = binary_reason_literal (reason);
+      assert (var (other).unit_id);
+      chain.push_back (var (other).unit_id);
+      chain.push_back (id);
+    } else if (proof && chain.empty () && reason && reason != decision_reason) {
       for (const_literal_iterator l = reason->begin (); l != reason->end (); l++) {
         const int lit2 = *l;
         if (lit2 == lit) continue;
@@ -80,6 +91,7 @@ inline void Internal::search_assign (int lit, Clause * reason) {
   v.trail = (int) trail.size ();
   v.reason = reason;
   if (!lit_level) learn_unit_clause (lit);  // increases 'stats.fixed'
+  else v.binary_id = id;
   const signed char tmp = sign (lit);
   vals[idx] = tmp;
   vals[-idx] = -tmp;
@@ -94,6 +106,8 @@ inline void Internal::search_assign (int lit, Clause * reason) {
 #endif
 
   if (watching ()) {
+    const Binaries & bs = binary_watches (-lit);
+    if (!bs.empty ()) __builtin_prefetch (&bs[0], 0, 1);
     const Watches & ws = watches (-lit);
     if (!ws.empty ()) {
       const Watch & w = ws[0];
@@ -127,9 +141,9 @@ void Internal::search_assume_decision (int lit) {
   search_assign (lit, decision_reason);
 }
 
-void Internal::search_assign_driving (int lit, Clause * c) {
+void Internal::search_assign_driving (int lit, Clause * c, clause_id_t id) {
   require_mode (SEARCH);
-  search_assign (lit, c);
+  search_assign (lit, c, id);
 }
 
 /*------------------------------------------------------------------------*/
@@ -142,9 +156,9 @@ void Internal::search_assign_driving (int lit, Clause * c) {
 // This version of 'propagate' uses lazy watches and keeps two watched
 // literals at the beginning of the clause.  We also use 'blocking literals'
 // to reduce the number of times clauses have to be visited (2008 JSAT paper
-// by Chu, Harwood and Stuckey).  The watches know if a watched clause is
-// binary, in which case it never has to be visited.  If a binary clause is
-// falsified we continue propagating.
+// by Chu, Harwood and Stuckey).  Binary clauses are watched in separate
+// watch lists, which are traversed first and never have to visit the
+// clause.  If a binary clause is falsified we continue propagating.
 
 // Finally, for long clauses we save the position of the last watch
 // replacement in 'pos', which in turn reduces certain quadratic accumulated
@@ -163,10 +177,36 @@ bool Internal::propagate () {
   //
   int64_t before = propagated;
 
+  // Optionally prefetch the clause of the watch 'prefetch' positions ahead
+  // in the watch list if it is not blocked, in order to overlap its cache
+  // miss with the work on the current watches.
+  //
+  const int prefetch = opts.prefetch;
+
   while (!conflict && propagated != trail.size ()) {
 
     const int lit = -trail[propagated++];
     LOG ("propagating %d", -lit);
+
+    // Binary clauses are watched separately and propagated first.  Since
+    // they are not allocated (see 'watch.hpp') the reason of an implied
+    // literal is the other literal tagged as binary reason and a falsified
+    // binary clause is copied to 'binary_conflict_clause' to be analyzed.
+    // Deleted binary clauses are removed from the watch lists immediately
+    // and thus never propagated.  If a binary clause is falsified we
+    // continue propagating binary clauses.
+
+    for (const auto & w : binary_watches (lit)) {
+      const signed char b = val (w.blit);
+      if (b > 0) continue;
+      if (b < 0)                                  // but continue ...
+        conflict = binary_clause (&binary_conflict_clause,
+                                  lit, w.blit, binary_id (w), w.redundant);
+      else search_assign (w.blit, binary_reason (lit), binary_id (w));
+    }
+
+    if (conflict) break; // Stop if there was a binary conflict already.
+
     Watches & ws = watches (lit);
 
     const const_watch_iterator eow = ws.end ();
@@ -175,178 +215,164 @@ bool Internal::propagate () {
 
     while (i != eow) {
 
+      if (prefetch && eow - i > prefetch) {
+        const Watch & ahead = i[prefetch];
+        if (val (ahead.blit) <= 0)
+          __builtin_prefetch (watched (ahead), 1, 0);
+      }
+
       const Watch w = *j++ = *i++;
       const signed char b = val (w.blit);
 
       if (b > 0) continue;                // blocking literal satisfied
 
-      if (w.binary ()) {
-
-        // In principle we can ignore garbage binary clauses too, but that
-        // would require to dereference the clause pointer all the time with
-        //
-        // if (w.clause->garbage) { j--; continue; } // (*)
-        //
-        // This is too costly.  It is however necessary to produce correct
-        // proof traces if binary clauses are traced to be deleted ('d ...'
-        // line) immediately as soon they are marked as garbage.  Actually
-        // finding instances where this happens is pretty difficult (six
-        // parallel fuzzing jobs in parallel took an hour), but it does
-        // occur.  Our strategy to avoid generating incorrect proofs now is
-        // to delay tracing the deletion of binary clauses marked as garbage
-        // until they are really deleted from memory.  For large clauses
-        // this is not necessary since we have to access the clause anyhow.
-        //
-        // Thanks go to Mathias Fleury, who wanted me to explain why the
-        // line '(*)' above was in the code. Removing it actually really
-        // improved running times and thus I tried to find concrete
-        // instances where this happens (which I found), and then
-        // implemented the described fix.
-
-        // Binary clauses are treated separately since they do not require
-        // to access the clause at all (only during conflict analysis, and
-        // there also only to simplify the code).
-
-        if (b < 0) conflict = w.clause;          // but continue ...
-        else search_assign (w.blit, w.clause);
-
-      } else {
-
-        if (conflict) break; // Stop if there was a binary conflict already.
-
-        // The cache line with the clause data is forced to be loaded here
-        // and thus this first memory access below is the real hot-spot of
-        // the solver.  Note, that this check is positive very rarely and
-        // thus branch prediction should be almost perfect here.
-
-        if (w.clause->garbage) { j--; continue; }
-
-        literal_iterator lits = w.clause->begin ();
-
-        // Simplify code by forcing 'lit' to be the second literal in the
-        // clause.  This goes back to MiniSAT.  We use a branch-less version
-        // for conditionally swapping the first two literals, since it
-        // turned out to be substantially faster than this one
-        //
-        //  if (lits[0] == lit) swap (lits[0], lits[1]);
-        //
-        // which achieves the same effect, but needs a branch.
-        //
-        const int other = lits[0] ^ lits[1] ^ lit;
-        const signed char u = val (other); // value of the other watch
-
-        if (u > 0) j[-1].blit = other; // satisfied, just replace blit
-        else {
-
-          // This follows Ian Gent's (JAIR'13) idea of saving the position
-          // of the last watch replacement.  In essence it needs two copies
-          // of the default search for a watch replacement (in essence the
-          // code in the 'if (v < 0) { ... }' block below), one starting at
-          // the saved position until the end of the clause and then if that
-          // one failed to find a replacement another one starting at the
-          // first non-watched literal until the saved position.
-
-          const int size = w.clause->size;
-          const literal_iterator middle = lits + w.clause->pos;
-          const const_literal_iterator end = lits + size;
-          literal_iterator k = middle;
-
-          // Find replacement watch 'r' at position 'k' with value 'v'.
-
-          int r = 0;
-          signed char v = -1;
-
-          while (k != end && (v = val (r = *k)) < 0)
-            k++;
-
-          if (v < 0) {  // need second search starting at the head?
-
-            k = lits + 2;
-            assert (w.clause->pos <= size);
-            while (k != middle && (v = val (r = *k)) < 0)
-              k++;
-          }
+#ifndef COMPACTWATCHES
+
+      // Watches of ternary clauses contain the third literal as second
+      // blocking literal.  If it is satisfied it is swapped with 'blit',
+      // without accessing the clause.  All other cases, in particular
+      // conflicts and units, go through the clause as for larger clauses,
+      // since it might be garbage and we have to update its watches.
+      //
+      if (w.tern && val (w.tern) > 0) {
+        j[-1].blit = w.tern;
+        j[-1].tern = w.blit;
+        continue;
+      }
+
+#endif
 
-          w.clause->pos = k - lits;  // always save position
+      // The cache line with the clause data is forced to be loaded here
+      // and thus this first memory access below is the real hot-spot of
+      // the solver.  Note, that this check is positive very rarely and
+      // thus branch prediction should be almost perfect here.
 
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+      Clause * c = watched (w);
+      if (c->garbage) { j--; continue; }
 
-          if (v > 0) {
+      literal_iterator lits = c->begin ();
 
-            // Replacement satisfied, so just replace 'blit'.
+      // Simplify code by forcing 'lit' to be the second literal in the
+      // clause.  This goes back to MiniSAT.  We use a branch-less version
+      // for conditionally swapping the first two literals, since it
+      // turned out to be substantially faster than this one
+      //
+      //  if (lits[0] == lit) swap (lits[0], lits[1]);
+      //
+      // which achieves the same effect, but needs a branch.
+      //
+      const int other = lits[0] ^ lits[1] ^ lit;
+      const signed char u = val (other); // value of the other watch
 
-            j[-1].blit = r;
+      if (u > 0) j[-1].blit = other; // satisfied, just replace blit
+      else {
 
-          } else if (!v) {
+        // This follows Ian Gent's (JAIR'13) idea of saving the position
+        // of the last watch replacement.  In essence it needs two copies
+        // of the default search for a watch replacement (in essence the
+        // code in the 'if (v < 0) { ... }' block below), one starting at
+        // the saved position until the end of the clause and then if that
+        // one failed to find a replacement another one starting at the
+        // first non-watched literal until the saved position.
 
-            // Found new unassigned replacement literal to be watched.
+        const int size = c->size;
+        const literal_iterator middle = lits + c->pos;
+        const const_literal_iterator end = lits + size;
+        literal_iterator k = middle;
 
-            LOG (w.clause, "unwatch %d in", lit);
+        // Find replacement watch 'r' at position 'k' with value 'v'.
 
-            lits[0] = other;
-            lits[1] = r;
-            *k = lit;
+        int r = 0;
+        signed char v = -1;
 
-            watch_literal (r, lit, w.clause);
+        k = find_non_false (k, end);
+        if (k != end) v = val (r = *k);
+        else {  // need second search starting at the head
 
-            j--;  // Drop this watch from the watch list of 'lit'.
+          assert (c->pos <= size);
+          k = find_non_false (lits + 2, middle);
+          if (k != middle) v = val (r = *k);
+        }
 
-          } else if (!u) {
+        c->pos = k - lits;  // always save position
 
-            assert (v < 0);
+        assert (lits + 2 <= k), assert (k <= c->end ());
 
-            // The other watch is unassigned ('!u') and all other literals
-            // assigned to false (still 'v < 0'), thus we found a unit.
-            //
-            search_assign (other, w.clause);
+        if (v > 0) {
 
-            // Similar code is in the implementation of the SAT'18 paper on
-            // chronological backtracking but in our experience, this code
-            // first does not really seem to be necessary for correctness,
-            // and further does not improve running time either.
-            //
-            if (opts.chrono > 1) {
+          // Replacement satisfied, so just replace 'blit'.
 
-              const int other_level = var (other).level;
+          j[-1].blit = r;
 
-              if (other_level > var (lit).level) {
+        } else if (!v) {
 
-                // The assignment level of the new unit 'other' is larger
-                // than the assignment level of 'lit'.  Thus we should find
-                // another literal in the clause at that higher assignment
-                // level and watch that instead of 'lit'.
+          // Found new unassigned replacement literal to be watched.
 
-                assert (size > 2);
+          LOG (c, "unwatch %d in", lit);
 
-                int pos, s = 0;
+          lits[0] = other;
+          lits[1] = r;
+          *k = lit;
 
-                for (pos = 2; pos < size; pos++)
-                  if (var (s = lits[pos]).level == other_level)
-                    break;
+          watch_literal (r, lit, c);
 
-                assert (s);
-                assert (pos < size);
+          j--;  // Drop this watch from the watch list of 'lit'.
 
-                LOG (w.clause, "unwatch %d in", lit);
-                lits[pos] = lit;
-                lits[0] = other;
-                lits[1] = s;
-                watch_literal (s, other, w.clause);
+        } else if (!u) {
 
-                j--;  // Drop this watch from the watch list of 'lit'.
-              }
-            }
-          } else {
+          assert (v < 0);
+
+          // The other watch is unassigned ('!u') and all other literals
+          // assigned to false (still 'v < 0'), thus we found a unit.
+          //
+          search_assign (other, c);
+
+          // Similar code is in the implementation of the SAT'18 paper on
+          // chronological backtracking but in our experience, this code
+          // first does not really seem to be necessary for correctness,
+          // and further does not improve running time either.
+          //
+          if (opts.chrono > 1) {
+
+            const int other_level = var (other).level;
+
+            if (other_level > var (lit).level) {
 
-            assert (u < 0);
-            assert (v < 0);
+              // The assignment level of the new unit 'other' is larger
+              // than the assignment level of 'lit'.  Thus we should find
+              // another literal in the clause at that higher assignment
+              // level and watch that instead of 'lit'.
 
-            // The other watch is assigned false ('u < 0') and all other
-            // literals as well (still 'v < 0'), thus we found a conflict.
+              assert (size > 2);
 
-            conflict = w.clause;
-            break;
+              int pos, s = 0;
+
+              for (pos = 2; pos < size; pos++)
+                if (var (s = lits[pos]).level == other_level)
+                  break;
+
+              assert (s);
+              assert (pos < size);
+
+              LOG (c, "unwatch %d in", lit);
+              lits[pos] = lit;
+              lits[0] = other;
+              lits[1] = s;
+              watch_literal (s, other, c);
+
+              j--;  // Drop this watch from the watch list of 'lit'.
+            }
           }
+        } else {
+
+          assert (u < 0);
+          assert (v < 0);
+
+          // The other watch is assigned false ('u < 0') and all other
+          // literals as well (still 'v < 0'), thus we found a conflict.
+
+          conflict = c;
+          break;
         }
       }
     }
@@ -28,6 +28,29 @@ bool Internal::flushing () {
 
 /*------------------------------------------------------------------------*/
 
+// Binary clauses do not record whether they were used recently.  Thus
+// hyper binary resolvents are only kept until the next reduction (or
+// flush) unless they are reasons.  Other learned binary clauses are kept.
+
+int64_t Internal::delete_hyper_binary_clauses () {
+  if (!hyper_binaries) return 0;
+  int64_t deleted = 0;
+  for (auto lit : lits) {
+    Binaries & bs = binary_watches (lit);
+    const auto end = bs.end ();
+    auto j = bs.begin (), i = j;
+    while (i != end) {
+      const Binary w = *j++ = *i++;
+      if (!w.hyper) continue;
+      if (binary_is_reason (lit, w)) continue;
+      if (lit < w.blit) delete_binary (lit, w), deleted++;
+      j--;
+    }
+    bs.resize (j - bs.begin ());
+  }
+  return deleted;
+}
+
 void Internal::mark_clauses_to_be_flushed () {
   for (const auto & c : clauses) {
     if (!c->redundant) continue; // keep irredundant
@@ -40,6 +63,7 @@ void Internal::mark_clauses_to_be_flushed () {
     if (c->hyper) stats.flush.hyper++;
     else stats.flush.learned++;
   }
+  stats.flush.hyper += delete_hyper_binary_clauses ();
   // No change to 'lim.kept{size,glue}'.
 }
 
@@ -53,15 +77,20 @@ void Internal::mark_clauses_to_be_flushed () {
 //
 // In earlier versions we pre-computed a 64-bit sort key per clause and
 // wrapped a pointer to the clause and the 64-bit sort key into a separate
-// data structure for sorting.  This was probably faster but awkward and
-// so we moved back to a simpler scheme which also uses 'stable_sort'
-// instead of 'rsort' below.  Sorting here is not a hot-spot anyhow.
-
-struct reduce_less_useful {
-  bool operator () (const Clause * c, const Clause * d) const {
-    if (c->glue > d->glue) return true;
-    if (c->glue < d->glue) return false;
-    return c->size > d->size;
+// data structure for sorting.  Then we moved to 'stable_sort' with a less
+// than function on glue and size, which however for tens of millions of
+// redundant clauses makes 'reduce' expensive.  Now the key is computed on
+// the fly by the following rank for the (stable) radix sort 'rsort', which
+// only needs a few passes over the candidates, since it skips the bytes
+// of the key which are the same for all clauses.  Clauses with larger glue
+// and then larger size get a smaller rank and thus come first.
+
+struct reduce_less_useful_rank {
+  typedef uint64_t Type;
+  Type operator () (const Clause * c) const {
+    const Type glue = ~(uint32_t) c->glue;
+    const Type size = ~(uint32_t) c->size;
+    return (glue << 32) | size;
   }
 };
 
@@ -77,6 +106,8 @@ void Internal::mark_useless_redundant_clauses_as_garbage () {
   // into the candidate selection (more recently learned clauses are kept if
   // they otherwise have the same glue and size).
 
+  delete_hyper_binary_clauses ();
+
   vector<Clause *> stack;
 
   stack.reserve (stats.current.redundant);
@@ -98,7 +129,7 @@ void Internal::mark_useless_redundant_clauses_as_garbage () {
     stack.push_back (c);
   }
 
-  stable_sort (stack.begin (), stack.end (), reduce_less_useful ());
+  rsort (stack.begin (), stack.end (), reduce_less_useful_rank ());
 
   size_t target = 1e-2 * opts.reducetarget * stack.size ();
 
@@ -174,11 +205,15 @@ void Internal::reduce () {
 
   if (!propagate_out_of_order_units ()) goto DONE;
 
-  mark_satisfied_clauses_as_garbage ();
+  // Incremental collection marks satisfied clauses itself, since it needs
+  // the watched literals of clauses shrunken to binary clauses.
+  //
+  if (!opts.collectinc) mark_satisfied_clauses_as_garbage ();
   protect_reasons ();
   if (flush) mark_clauses_to_be_flushed ();
   else mark_useless_redundant_clauses_as_garbage ();
-  garbage_collection ();
+  if (opts.collectinc) incremental_garbage_collection ();
+  else garbage_collection ();
 
   {
     int64_t delta = opts.reduceint * (stats.reductions + 1);
@@ -219,7 +219,18 @@ namespace CaDiCaL {
     assert(v.level == blevel);
     assert(v.reason);
 
-    if (resolve_large_clauses || v.reason->size == 2)
+    if (is_binary_reason(v.reason))
+      {
+        const int lit = binary_reason_literal(v.reason);
+        LOG(v.reason, "resolving with reason");
+        assert(val(lit) < 0);
+        int tmp = shrink_literal(lit, blevel, max_trail);
+        if(tmp < 0)
+          failed_ptr = true;
+        else if(tmp > 0)
+          ++open;
+      }
+    else if (resolve_large_clauses)
       {
         const Clause &c = *v.reason;
         LOG(v.reason, "resolving with reason");
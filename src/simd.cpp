@@ -0,0 +1,41 @@
+#include "internal.hpp"
+
+#ifdef SIMD
+#include <immintrin.h>
+#endif
+
+namespace CaDiCaL {
+
+#ifdef SIMD
+
+bool simd_supported () {
+  __builtin_cpu_init ();
+  return __builtin_cpu_supports ("avx2");
+}
+
+// The values are gathered as 32-bit words at byte offsets 'vals + lit' and
+// then shifted left by 24 bits, which moves the sign bit of the value of
+// each literal into the sign bit of its lane.  Thus 'movemask' gives a bit
+// mask of literals assigned to false.  The remaining (less than eight)
+// literals are checked one by one.
+
+__attribute__ ((target ("avx2")))
+int * simd_find_non_false (const signed char * vals,
+                           int * k, const int * end) {
+  const int * base = (const int *) vals;
+  while (end - k >= 8) {
+    const __m256i lits = _mm256_loadu_si256 ((const __m256i *) k);
+    const __m256i words = _mm256_i32gather_epi32 (base, lits, 1);
+    const __m256i signs = _mm256_slli_epi32 (words, 24);
+    const int mask = _mm256_movemask_ps (_mm256_castsi256_ps (signs));
+    if (mask != 0xff) return k + __builtin_ctz (~mask);
+    k += 8;
+  }
+  while (k != end && vals[*k] < 0)
+    k++;
+  return k;
+}
+
+#endif
+
+}
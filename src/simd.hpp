@@ -0,0 +1,33 @@
+#ifndef _simd_hpp_INCLUDED
+#define _simd_hpp_INCLUDED
+
+namespace CaDiCaL {
+
+// If compiled with '-DSIMD' (configure with '--simd') the search for a
+// replacement watch in long clauses during propagation (in 'propagate' and
+// 'probe_propagate') uses an AVX2 kernel, which gathers the values of eight
+// literals at once.  Whether the processor supports AVX2 is only checked
+// at run-time (see 'simd_supported') and otherwise the scalar search in
+// 'Internal::find_non_false' is used.  Since starting the kernel has some
+// overhead it is only used for at least 'simd_min_literals' literals.
+
+#ifdef SIMD
+
+const int simd_min_literals = 8;
+
+// Returns 'true' if the vector kernel can be used on this processor.
+
+bool simd_supported ();
+
+// Returns the first literal in '[k,end)' which is not assigned to false or
+// 'end' if there is none.  The gather instruction reads four bytes at
+// 'vals + lit' and thus 'vals' needs three bytes padding at its end.
+
+int * simd_find_non_false (const signed char * vals,
+                           int * k, const int * end);
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include "internal.hpp"
+
+#ifndef __WIN32
+extern "C" {
+#include <sys/mman.h>
+}
+#endif
+
+namespace CaDiCaL {
+
+// Chunks are mapped directly, since 'malloc' would keep freed chunks in
+// its heap (after the first freed chunk raised its mapping threshold) and
+// mixed with other allocations they are less likely given back.
+
+static char * new_chunk () {
+#ifndef __WIN32
+  void * res = mmap (0, slab_chunk_bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (res == MAP_FAILED) fatal ("can not allocate slab chunk");
+  return (char *) res;
+#else
+  return new char[slab_chunk_bytes];
+#endif
+}
+
+static void delete_chunk (char * chunk) {
+#ifndef __WIN32
+  munmap (chunk, slab_chunk_bytes);
+#else
+  delete [] chunk;
+#endif
+}
+
+Slab::Slab () : top (0), end (0), nonempty (0), live (0) {
+  memset (free, 0, sizeof free);
+}
+
+Slab::~Slab () {
+  for (const auto & chunk : chunks)
+    delete_chunk (chunk);
+}
+
+// Split the smallest free block larger than 'bytes' and put the rest on
+// the free list of its size class.  This reuses memory given back before
+// touching new memory.
+
+char * Slab::split (size_t bytes) {
+  const unsigned i = bytes / 8;
+  assert (i < slab_classes), assert (nonempty >> i);
+  const unsigned j = i + 1 + __builtin_ctzll (nonempty >> i);
+  assert (j <= slab_classes);
+  char * res = pop (j);
+  push (res + bytes, j - i);
+  return res;
+}
+
+// The remaining memory of the current chunk is too small for the clause
+// and thus put on the free list of its size class.
+
+void Slab::refill () {
+  if (top != end) push (top, (end - top) / 8);
+  top = new_chunk ();
+  end = top + slab_chunk_bytes;
+  chunks.insert (upper_bound (chunks.begin (), chunks.end (), top), top);
+}
+
+void Slab::release (vector<char *> & used) {
+
+  if (chunks.empty ()) return;
+
+  vector<bool> keep (chunks.size ());
+  size_t kept = 0;
+
+  if (live) {
+    sort (used.begin (), used.end ());
+    size_t k = 0;
+    for (const auto & p : used) {
+      while (k < chunks.size () && chunks[k] + slab_chunk_bytes <= p) k++;
+      if (k == chunks.size ()) break;
+      if (p < chunks[k] || keep[k]) continue;
+      keep[k] = true;
+      kept++;
+    }
+  }
+
+  if (kept == chunks.size ()) return;
+
+  // Index of the chunk containing 'p'.
+  //
+  auto chunk = [this] (const char * p) {
+    auto i = upper_bound (chunks.begin (), chunks.end (), p);
+    assert (i != chunks.begin ());
+    const size_t k = --i - chunks.begin ();
+    assert (p < chunks[k] + slab_chunk_bytes);
+    return k;
+  };
+
+  // Remove the free blocks in released chunks from the free lists.
+  //
+  nonempty = 0;
+  for (unsigned i = 1; i <= slab_classes; i++) {
+    char * p = free[i];
+    free[i] = 0;
+    while (p) {
+      char * next = *(char **) p;
+      if (kept && keep[chunk (p)]) push (p, i);
+      p = next;
+    }
+  }
+
+  if (top && (!kept || !keep[chunk (end - 1)])) top = end = 0;
+
+  size_t j = 0;
+  for (size_t k = 0; k != chunks.size (); k++)
+    if (keep[k]) chunks[j++] = chunks[k];
+    else delete_chunk (chunks[k]);
+  chunks.resize (j);
+  shrink_vector (chunks);
+}
+
+}
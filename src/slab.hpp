@@ -0,0 +1,110 @@
+#ifndef _slab_hpp_INCLUDED
+#define _slab_hpp_INCLUDED
+
+namespace CaDiCaL {
+
+// Clauses are allocated and deleted at a very high rate, particularly
+// learned clauses during search and resolvents during elimination.  Going
+// through the global heap for each clause induces substantial overhead in
+// 'malloc' and 'free' and fragments the heap.  Instead (if 'opts.slab' is
+// enabled) clauses are allocated through this slab allocator.  Clauses
+// of at most 'max_slab_bytes' are bumped from large chunks and there is a
+// free list for every size class, i.e., every multiple of eight bytes.
+// Deleting a clause (for instance in 'delete_garbage_clauses' or after
+// moving it to the arena in 'copy_non_garbage_clauses') pushes its memory
+// on the free list of its size class, which is then used first for new
+// clauses.  If that list is empty, the smallest larger free block is split
+// before new memory is bumped.  The few larger clauses are allocated on
+// the heap but still go through the slab, which determines by their
+// address whether memory is in a chunk ('contains').
+
+// The memory freed by shrinking a clause in place (see 'shrink_clause') is
+// put on the free list of its size class.  After garbage collection chunks
+// without live clauses are released (see 'release').  Since the moving
+// collector copies all clauses to the arena, this gives back all chunks
+// after each such collection.
+
+const size_t max_slab_bytes = 512;
+const size_t slab_chunk_bytes = 1 << 20;
+const unsigned slab_classes = max_slab_bytes / 8;
+
+class Slab {
+
+  char * top, * end;                            // current chunk
+  char * free[slab_classes + 1];                // free lists per size
+  uint64_t nonempty;                            // bit 'i-1' for 'free[i]'
+  vector<char *> chunks;                        // sorted chunks
+  size_t live;                                  // bytes used in chunks
+
+  void push (char * p, unsigned i) {
+    assert (0 < i), assert (i <= slab_classes);
+    *(char **) p = free[i];
+    free[i] = p;
+    nonempty |= (uint64_t) 1 << (i - 1);
+  }
+
+  char * pop (unsigned i) {
+    char * res = free[i];
+    assert (res);
+    if (!(free[i] = *(char **) res)) nonempty &= ~((uint64_t) 1 << (i - 1));
+    return res;
+  }
+
+  char * split (size_t bytes);
+  void refill ();
+
+public:
+
+  Slab ();
+  ~Slab ();
+
+  static bool fits (size_t bytes) { return bytes <= max_slab_bytes; }
+
+  bool contains (const char * p) const {
+    auto i = upper_bound (chunks.begin (), chunks.end (), p);
+    return i != chunks.begin () && p < *--i + slab_chunk_bytes;
+  }
+
+  char * allocate (size_t bytes) {
+    assert (!(bytes & 7));
+    if (!fits (bytes)) return new char[bytes];
+    live += bytes;
+    const unsigned i = bytes / 8;
+    if (free[i]) return pop (i);
+    if (i < slab_classes && (nonempty >> i)) return split (bytes);
+    if ((size_t) (end - top) < bytes) refill ();
+    char * res = top;
+    top += bytes;
+    return res;
+  }
+
+  void deallocate (char * p, size_t bytes) {
+    assert (!(bytes & 7));
+    if (!contains (p)) { delete [] p; return; }
+    assert (fits (bytes)), assert (live >= bytes);
+    live -= bytes;
+    push (p, bytes / 8);
+  }
+
+  // The clause at 'p' shrunk from 'old_bytes' to 'new_bytes'.
+
+  void shrink (char * p, size_t old_bytes, size_t new_bytes) {
+    assert (new_bytes <= old_bytes), assert (!(new_bytes & 7));
+    if (new_bytes == old_bytes || !contains (p)) return;
+    assert (live >= old_bytes - new_bytes);
+    live -= old_bytes - new_bytes;
+    push (p + new_bytes, (old_bytes - new_bytes) / 8);
+  }
+
+  // Release chunks which do not contain any of the 'used' allocations,
+  // which have to be all the live ones (sorts 'used').
+
+  bool empty () const { return !live; }
+  void release (vector<char *> & used);
+
+  size_t bytes () const { return chunks.size () * slab_chunk_bytes; }
+};
+
+}
+
+#endif
@@ -1,5 +1,4 @@
 #include "internal.hpp"
-#include "learnerobserver.hpp"
 
 /*------------------------------------------------------------------------*/
 
@@ -458,6 +457,7 @@ bool Solver::set (const char * arg, int val) {
       arg, val);
   }
   bool res = internal->opts.set (arg, val);
+  if (res) internal->init_clause_ids ();
   LOG_API_CALL_END ("set", arg, val, res);
   return res;
 }
@@ -515,6 +515,7 @@ bool Solver::configure (const char * name) {
   REQUIRE (state () == CONFIGURING,
     "can only set configuration '%s' right after initialization", name);
   bool res = Config::set (internal->opts, name);
+  if (res) internal->init_clause_ids ();
   LOG_API_CALL_END ("configure", name, res);
   return res;
 }
@@ -719,8 +720,7 @@ void Solver::connect_learner (Learner * learner) {
     LOG ("connecting new learner (no previous one)");
 #endif
   external->learner = learner;
-  LearnerObserver *lo = new LearnerObserver (external);
-  if (external->internal->proof) external->internal->proof->connect(lo);
+  external->connect_learner_observer ();
   LOG_API_CALL_END ("connect_learner");
 }
 
@@ -737,6 +737,35 @@ void Solver::disconnect_learner () {
   LOG_API_CALL_END ("disconnect_learner");
 }
 
+void Solver::connect_clause_exporter (ClauseExporter * exporter,
+                                      int batch) {
+  LOG_API_CALL_BEGIN ("connect_clause_exporter");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (exporter, "can not connect zero clause exporter");
+  REQUIRE (batch >= 0, "negative export batch size");
+  if (external->exporter) {
+    LOG ("connecting new clause exporter (disconnecting previous one)");
+    external->flush_exported_clauses ();
+  } else
+    LOG ("connecting new clause exporter (no previous one)");
+  external->exporter = exporter;
+  external->export_batch = batch;
+  external->connect_learner_observer ();
+  LOG_API_CALL_END ("connect_clause_exporter");
+}
+
+void Solver::disconnect_clause_exporter () {
+  LOG_API_CALL_BEGIN ("disconnect_clause_exporter");
+  REQUIRE_VALID_STATE ();
+  if (external->exporter) {
+    LOG ("disconnecting previous clause exporter");
+    external->flush_exported_clauses ();
+  } else
+    LOG ("ignoring to disconnect clause exporter (no previous one)");
+  external->exporter = 0;
+  LOG_API_CALL_END ("disconnect_clause_exporter");
+}
+
 void Solver::connect_learn_source (LearnSource * learnSource) {
   external->learnSource = learnSource;
 }
@@ -841,14 +870,6 @@ bool Solver::trace_proof (const char * path) {
   File * internal_file = File::write (internal, path);
   bool res = (internal_file != 0);
   internal->trace (internal_file);
-  // disable options which don't work together with LRAT proof tracing
-  bool ok;
-  ok = set("decompose", 0); assert(ok);
-  ok = set("elim", 0); assert(ok);
-  ok = set("probe", 0); assert(ok);
-  ok = set("ternary", 0); assert(ok);
-  ok = set("transred", 0); assert(ok);
-  ok = set("vivify", 0); assert(ok);
   LOG_API_CALL_RETURNS ("trace_proof", path, res);
   return res;
 }
@@ -106,6 +106,10 @@ void Stats::print (Internal * internal) {
   PRT ("  elimsubst:     %15" PRId64 "   %10.2f %%  substituted", stats.elimsubst, percent (stats.elimsubst, stats.all.eliminated));
   PRT ("  elimres:       %15" PRId64 "   %10.2f    per eliminated", stats.elimres, relative (stats.elimres, stats.all.eliminated));
   PRT ("  elimrestried:  %15" PRId64 "   %10.2f %%  per resolution", stats.elimrestried, percent (stats.elimrestried, stats.elimres));
+  if (all || stats.elimchecks) {
+  PRT ("  elimchecks:    %15" PRId64 "   %10.2f %%  per tried", stats.elimchecks, percent (stats.elimchecks, stats.elimtried));
+  PRT ("  elimchecked:   %15" PRId64 "   %10.2f %%  of checks", stats.elimchecked, percent (stats.elimchecked, stats.elimchecks));
+  }
   }
   if (all || stats.all.fixed) {
   PRT ("fixed:           %15" PRId64 "   %10.2f %%  of all variables", stats.all.fixed, percent (stats.all.fixed, stats.vars));
@@ -128,6 +132,19 @@ void Stats::print (Internal * internal) {
   PRT ("  hyper:         %15" PRId64 "   %10.2f %%  per conflict", stats.flush.hyper, relative (stats.flush.hyper, stats.conflicts));
   PRT ("  flushings:     %15" PRId64 "   %10.2f    interval", stats.flush.count, relative (stats.conflicts, stats.flush.count));
   }
+  if (all || stats.import.received) {
+  PRT ("imported:        %15" PRId64 "   %10.2f %%  of received", stats.import.imported, percent (stats.import.imported, stats.import.received));
+  PRT ("  received:      %15" PRId64 "   %10.2f    per round", stats.import.received, relative (stats.import.received, stats.import.rounds));
+  PRT ("  rejected:      %15" PRId64 "   %10.2f %%  of received", stats.import.rejected, percent (stats.import.rejected, stats.import.received));
+  PRT ("  deferred:      %15" PRId64 "   %10.2f    per round", stats.import.deferred, relative (stats.import.deferred, stats.import.rounds));
+  PRT ("  dropped:       %15" PRId64 "   %10.2f %%  of received", stats.import.dropped, percent (stats.import.dropped, stats.import.received));
+  PRT ("  duplicated:    %15" PRId64 "   %10.2f %%  of received", stats.import.duplicated, percent (stats.import.duplicated, stats.import.received));
+  PRT ("  hashed:        %15" PRId64 "   %10.2f    per round", stats.import.hashed, relative (stats.import.hashed, stats.import.rounds));
+  PRT ("  skipped:       %15" PRId64 "   %10.2f %%  of received", stats.import.skipped, percent (stats.import.skipped, stats.import.received));
+  PRT ("  propagating:   %15" PRId64 "   %10.2f %%  of imported", stats.import.propagating, percent (stats.import.propagating, stats.import.imported));
+  PRT ("  conflicting:   %15" PRId64 "   %10.2f %%  of imported", stats.import.conflicting, percent (stats.import.conflicting, stats.import.imported));
+  PRT ("  importrounds:  %15" PRId64 "   %10.2f    interval", stats.import.rounds, relative (stats.conflicts, stats.import.rounds));
+  }
   if (all || stats.instantiated) {
   PRT ("instantiated:    %15" PRId64 "   %10.2f %%  of tried", stats.instantiated, percent (stats.instantiated, stats.instried));
   PRT ("  instrounds:    %15" PRId64 "   %10.2f %%  of elimrounds", stats.instrounds, percent (stats.instrounds, stats.elimrounds));
@@ -172,6 +189,9 @@ void Stats::print (Internal * internal) {
   PRT ("reduced:         %15" PRId64 "   %10.2f %%  per conflict", stats.reduced, percent (stats.reduced, stats.conflicts));
   PRT ("  reductions:    %15" PRId64 "   %10.2f    interval", stats.reductions, relative (stats.conflicts, stats.reductions));
   PRT ("  collections:   %15" PRId64 "   %10.2f    interval", stats.collections, relative (stats.conflicts, stats.collections));
+  if (all || stats.collectinc) {
+  PRT ("  collectinc:    %15" PRId64 "   %10.2f %%  of collections", stats.collectinc, percent (stats.collectinc, stats.collections));
+  }
   }
   if (all || stats.rephased.total) {
   PRT ("rephased:        %15" PRId64 "   %10.2f    interval", stats.rephased.total, relative (stats.conflicts, stats.rephased.total));
@@ -85,6 +85,20 @@ struct Stats {
     int64_t minimum;
   } walk;
 
+  struct {
+    int64_t rounds;     // number of import rounds
+    int64_t received;   // clauses received from learn source
+    int64_t rejected;   // rejected due to glue or size limits
+    int64_t deferred;   // deferred to later rounds (counted per round)
+    int64_t dropped;    // dropped since import queue is full
+    int64_t duplicated; // dropped since recently seen (fingerprint)
+    int64_t hashed;     // fingerprints added to table
+    int64_t skipped;    // satisfied or with eliminated literals
+    int64_t imported;   // actually imported clauses
+    int64_t propagating; // imported clauses propagating during search
+    int64_t conflicting; // imported clauses conflicting during search
+  } import;
+
   struct {
     int64_t count;      // flushings of learned clauses counter
     int64_t learned;    // flushed learned clauses
@@ -115,6 +129,7 @@ struct Stats {
   int64_t reduced;      // number of reduced clauses
   int64_t collected;    // number of collected bytes
   int64_t collections;  // number of garbage collections
+  int64_t collectinc;   // number of incremental garbage collections
   int64_t hbrs;         // hyper binary resolvents
   int64_t hbrsizes;     // sum of hyper resolved base clauses
   int64_t hbreds;       // redundant hyper binary resolvents
@@ -143,6 +158,8 @@ struct Stats {
   int64_t elimphases;   // number of scheduled elimination phases
   int64_t elimcompleted;// number complete elimination procedures
   int64_t elimtried;    // number of variable elimination attempts
+  int64_t elimchecks;   // number of candidates checked in parallel
+  int64_t elimchecked;  // number of parallel checks used
   int64_t elimsubst;    // number of eliminations through substitutions
   int64_t elimgates;    // number of gates found during elimination
   int64_t elimequivs;   // number of equivalences found during elimination
@@ -405,6 +405,20 @@ bool Internal::subsume_round () {
   }
   shrink_vector (schedule);
 
+  // Binary clauses are not scheduled, since they are never subsumed here,
+  // but irredundant ones are connected below before all other clauses.
+  // Redundant binary clauses are ignored (they would need to be turned
+  // into irredundant clauses if they subsume an irredundant clause).
+  //
+  for (auto lit : lits) {
+    if (val (lit) || !flags (lit).subsume) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (w.redundant) continue;
+      if (val (w.blit) || !flags (w.blit).subsume) continue;
+      noccs (lit)++;
+    }
+  }
+
   // Smaller clauses are checked and connected first.
   //
   rsort (schedule.begin (), schedule.end (), smaller_clause_size_rank ());
@@ -435,6 +449,22 @@ bool Internal::subsume_round () {
   init_occs ();
   init_bins ();
 
+  for (auto lit : lits) {
+    if (val (lit) || !flags (lit).subsume) continue;
+    for (const auto & w : binary_watches (lit)) {
+      if (w.redundant || lit > w.blit) continue;
+      const int other = w.blit;
+      if (val (other) || !flags (other).subsume) continue;
+      const size_t size = bins (lit).size (), osize = bins (other).size ();
+      int minlit = lit;
+      if (osize < size || (osize == size && noccs (other) > noccs (lit)))
+        minlit = other;
+      if (bins (minlit).size () > (size_t) opts.subsumebinlim) continue;
+      LOG ("watching %d of binary clause %d %d", minlit, lit, other);
+      bins (minlit).push_back (Bin{lit ^ other ^ minlit, binary_id (w)});
+    }
+  }
+
   for (const auto & s : schedule) {
 
     if (terminated_asynchronously ()) break;
@@ -558,8 +588,11 @@ bool Internal::subsume_round () {
   if (completed)
     reset_subsume_bits ();
 
-  for (const auto & c : shrunken)
+  for (const auto & c : shrunken) {
     mark_added (c);
+    if (c->size == 2 && !c->garbage && !explicit_binaries)
+      make_binary_implicit (c);
+  }
   erase_vector (shrunken);
 
   report ('s', !opts.reportall && !(subsumed + strengthened));
@@ -19,24 +19,21 @@ namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
-// Check whether a binary clause consisting of the permutation of the given
-// literals already exists.
+// Check whether a binary clause consisting of the given literals already
+// exists.  Binary clauses are not connected to the occurrence lists but
+// found in the binary watches.
 
 bool
 Internal::ternary_find_binary_clause (int a, int b) {
   assert (occurring ());
   assert (active (a));
   assert (active (b));
-  size_t s = occs (a).size ();
-  size_t t = occs (b).size ();
-  int lit = s < t ? a : b;
-  if (opts.ternaryocclim < (int) occs (lit).size ()) return true;
-  for (const auto & c : occs (lit)) {
-    if (c->size != 2) continue;
-    const int * lits = c->literals;
-    if (lits[0] == a && lits[1] == b) return true;
-    if (lits[0] == b && lits[1] == a) return true;
-  }
+  size_t s = binary_watches (a).size ();
+  size_t t = binary_watches (b).size ();
+  int lit = s < t ? a : b, other = a ^ b ^ lit;
+  if (opts.ternaryocclim < (int) binary_watches (lit).size ()) return true;
+  for (const auto & w : binary_watches (lit))
+    if (w.blit == other) return true;
   return false;
 }
 
@@ -58,24 +55,19 @@ Internal::ternary_find_ternary_clause (int a, int b, int c) {
   if (r < s) lit = (t < r) ? c : a;
   else       lit = (t < s) ? c : b;
   if (opts.ternaryocclim < (int) occs (lit).size ()) return true;
+  for (const auto & w : binary_watches (lit)) {
+    const int other = w.blit;
+    if (other == a || other == b || other == c) return true;
+  }
   for (const auto & d : occs (lit)) {
     const int * lits = d->literals;
-    if (d->size == 2) {
-      if (lits[0] == a && lits[1] == b) return true;
-      if (lits[0] == b && lits[1] == a) return true;
-      if (lits[0] == a && lits[1] == c) return true;
-      if (lits[0] == c && lits[1] == a) return true;
-      if (lits[0] == b && lits[1] == c) return true;
-      if (lits[0] == c && lits[1] == b) return true;
-    } else {
-      assert (d->size == 3);
-      if (lits[0] == a && lits[1] == b && lits[2] == c) return true;
-      if (lits[0] == a && lits[1] == c && lits[2] == b) return true;
-      if (lits[0] == b && lits[1] == a && lits[2] == c) return true;
-      if (lits[0] == b && lits[1] == c && lits[2] == a) return true;
-      if (lits[0] == c && lits[1] == a && lits[2] == b) return true;
-      if (lits[0] == c && lits[1] == b && lits[2] == a) return true;
-    }
+    assert (d->size == 3);
+    if (lits[0] == a && lits[1] == b && lits[2] == c) return true;
+    if (lits[0] == a && lits[1] == c && lits[2] == b) return true;
+    if (lits[0] == b && lits[1] == a && lits[2] == c) return true;
+    if (lits[0] == b && lits[1] == c && lits[2] == a) return true;
+    if (lits[0] == c && lits[1] == a && lits[2] == b) return true;
+    if (lits[0] == c && lits[1] == b && lits[2] == a) return true;
   }
   return false;
 }
@@ -133,7 +125,7 @@ void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
   for (const auto & c : occs (pivot)) {
     if (htrs < 0) break;
     if (c->garbage) continue;
-    if (c->size != 3) { assert (c->size == 2); continue; }
+    assert (c->size == 3);
     if (--steps < 0) break;
     bool assigned = false;
     for (const auto & lit : *c)
@@ -142,7 +134,7 @@ void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
     for (const auto & d : occs (-pivot)) {
       if (htrs < 0) break;
       if (d->garbage) continue;
-      if (d->size != 3) { assert (d->size == 2); continue; }
+      assert (d->size == 3);
       for (const auto & lit : *d)
         if (val (lit)) { assigned = true; break; }
       if (assigned) continue;
@@ -151,15 +143,15 @@ void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
       if (hyper_ternary_resolve (c, pivot, d)) {
         size_t size = clause.size ();
         bool red = (size == 3 || (c->redundant && d->redundant));
-        PROOF_TODO (proof, "hyper ternary resolution", 80); // TODO(Mario)
+        if (proof && opts.lrat) {
+          chain.push_back (c->id);
+          chain.push_back (d->id);
+        }
         Clause * r = new_hyper_ternary_resolved_clause (red);
-        if (red) r->hyper = true;
         clause.clear ();
-        LOG (r, "hyper ternary resolved");
         stats.htrs++;
-        for (const auto & lit : *r)
-          occs (lit).push_back (r);
         if (size == 2) {
+          assert (!r);
           LOG ("hyper ternary resolvent subsumes both antecedents");
           mark_garbage (c);
           mark_garbage (d);
@@ -167,6 +159,10 @@ void Internal::ternary_lit (int pivot, int64_t & steps, int64_t & htrs) {
           break;
         } else {
           assert (r->size == 3);
+          if (red) r->hyper = true;
+          LOG (r, "hyper ternary resolved");
+          for (const auto & lit : *r)
+            occs (lit).push_back (r);
           stats.htrs3++;
         }
       } else {
@@ -220,23 +216,26 @@ bool Internal::ternary_round (int64_t & steps_limit, int64_t & htrs_limit) {
   for (const auto & c : clauses) {
     if (c->garbage) continue;
     if (c->size > 3) continue;
+    assert (c->size == 3);
     bool assigned = false, marked = false;
     for (const auto & lit : *c) {
       if (val (lit)) { assigned = true; break; }
       if (flags (lit).ternary) marked = true;
     }
     if (assigned) continue;
-    if (c->size == 2) bincon++;
-    else {
-      assert (c->size == 3);
-      if (!marked) continue;
-      terncon++;
-    }
+    if (!marked) continue;
+    terncon++;
 
     for (const auto & lit : *c)
       occs (lit).push_back (c);
   }
 
+  for (auto lit : lits) {
+    if (val (lit)) continue;
+    for (const auto & w : binary_watches (lit))
+      if (lit < w.blit && !val (w.blit)) bincon++;
+  }
+
   PHASE ("ternary", stats.ternary,
     "connected %" PRId64 " ternary %.0f%% "
     "and %" PRId64 " binary clauses %.0f%%",
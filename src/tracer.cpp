@@ -4,22 +4,202 @@
 #include "internal.hpp"
 #include <sstream>
 
+#ifndef NTHREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
-Tracer::Tracer (Internal * i, File * f, bool b, bool l, bool fr, bool d) :
+// Blocks are written as soon as they reach this size (at a line end).
+
+static const size_t block_size = 1 << 22;
+
+#ifndef NTHREADS
+
+// Background thread writing full blocks to the proof file.  It owns the
+// block handed over by 'write' until it is written, which the search
+// thread only has to wait for if it fills the other block in the meantime.
+// Thus writing to disk or to a compressing pipe happens concurrently to
+// search.  The file is only accessed by this thread until it is deleted
+// or after 'wait' returned.  A failed write is recorded in 'failed' and
+// returned by the next 'write' or 'wait' to be reported by 'Tracer'.
+
+struct TracerWriter {
+
+  File * file;
+  const char * pending;         // block to be written or zero
+  size_t bytes;                 // size of pending block
+  bool failed;                  // writing a block failed
+  bool stop;
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::thread thread;
+
+  void run () {
+    std::unique_lock<std::mutex> lock (mutex);
+    for (;;) {
+      condition.wait (lock, [this] { return pending || stop; });
+      if (!pending) break;
+      const char * data = pending;
+      const size_t size = bytes;
+      lock.unlock ();
+      const bool written = file->write (data, size);
+      lock.lock ();
+      if (!written) failed = true;
+      pending = 0;
+      condition.notify_all ();
+    }
+  }
+
+  TracerWriter (File * f) :
+    file (f), pending (0), bytes (0), failed (false), stop (false),
+    thread (&TracerWriter::run, this) { }
+
+  ~TracerWriter () {
+    {
+      std::unique_lock<std::mutex> lock (mutex);
+      condition.wait (lock, [this] { return !pending; });
+      stop = true;
+      condition.notify_all ();
+    }
+    thread.join ();
+  }
+
+  bool wait () {
+    std::unique_lock<std::mutex> lock (mutex);
+    condition.wait (lock, [this] { return !pending; });
+    return !failed;
+  }
+
+  bool write (const char * data, size_t size) {
+    assert (data), assert (size);
+    std::unique_lock<std::mutex> lock (mutex);
+    condition.wait (lock, [this] { return !pending; });
+    if (failed) return false;
+    pending = data;
+    bytes = size;
+    condition.notify_all ();
+    return true;
+  }
+};
+
+#else
+
+struct TracerWriter { };
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// The 'lrat' option also enables the generation of chains, which are
+// needed for hints in FRAT proofs too.  Thus 'frat' selects the output
+// format if both are set (otherwise we would mix both formats).
+
+Tracer::Tracer (Internal * i, File * f, bool b, bool l, bool fr, bool d,
+                bool async, bool dl) :
   internal (i),
-  file (f), binary (b), lrat (l), frat (fr), should_delete_clauses(d),
+  file (f), binary (b), lrat (l && !fr), frat (fr),
+  delta (dl && b && l && !fr), should_delete_clauses(d),
+  last_id (0),
+  block (blocks), writer (0),
   added (0), deleted (0)
 {
-  (void) internal;
   LOG ("TRACER new");
+  for (auto & b : blocks)
+    b.begin = b.pos = b.end = 0;
+#ifndef NTHREADS
+  if (async && file) {
+    writer = new TracerWriter (file);
+    LOG ("TRACER writing proof asynchronously");
+  }
+#else
+  (void) async;
+#endif
 }
 
+// Write errors are only reported on 'flush' and 'close' (and while tracing)
+// but not while deleting the solver.
+
 Tracer::~Tracer () {
   LOG ("TRACER delete");
+  if (file && !file->closed ()) (void) write_block ();
+  delete writer;
   delete file;
+  for (auto & b : blocks)
+    delete [] b.begin;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Blocks are allocated on first use, thus the second block only if proofs
+// are written asynchronously.  Lines longer than the block size need
+// larger blocks.
+
+void Tracer::enlarge (size_t bytes) {
+  const size_t used = block->pos - block->begin;
+  size_t capacity = block->end - block->begin;
+  if (!capacity) capacity = block_size;
+  while (capacity - used < bytes) capacity *= 2;
+  char * begin = new char [capacity];
+  if (used) memcpy (begin, block->begin, used);
+  delete [] block->begin;
+  block->begin = begin;
+  block->pos = begin + used;
+  block->end = begin + capacity;
+}
+
+// Returns 'false' if writing failed, which for asynchronous writing might
+// also have happened for the previous block.
+
+bool Tracer::write_block () {
+  const size_t bytes = block->pos - block->begin;
+  if (!bytes) return true;
+  bool res;
+#ifndef NTHREADS
+  if (writer) {
+    res = writer->write (block->begin, bytes);
+    block->pos = block->begin;
+    block = (block == blocks) ? blocks + 1 : blocks;
+    assert (block->pos == block->begin);
+    return res;
+  }
+#endif
+  res = file->write (block->begin, bytes);
+  block->pos = block->begin;
+  return res;
+}
+
+void Tracer::write_error () {
+  internal->error ("failed to write proof trace to '%s'", file->name ());
+}
+
+inline void Tracer::end_line () {
+  if ((size_t) (block->pos - block->begin) >= block_size &&
+      !write_block ())
+    write_error ();
+}
+
+void Tracer::put (const char * s) {
+  const size_t len = strlen (s);
+  reserve (len);
+  memcpy (block->pos, s, len);
+  block->pos += len;
+}
+
+void Tracer::put (int64_t n) {
+  char buffer[21];
+  char * p = buffer + sizeof buffer;
+  uint64_t k = n < 0 ? - (uint64_t) n : (uint64_t) n;
+  do *--p = '0' + k % 10; while (k /= 10);
+  if (n < 0) *--p = '-';
+  const size_t len = buffer + sizeof buffer - p;
+  reserve (len);
+  memcpy (block->pos, p, len);
+  block->pos += len;
 }
 
 /*------------------------------------------------------------------------*/
@@ -29,7 +209,7 @@ Tracer::~Tracer () {
 inline void Tracer::put_binary_zero () {
   assert (binary);
   assert (file);
-  file->put ((unsigned char) 0);
+  put ((char) 0);
 }
 
 inline void Tracer::put_binary_lit (int lit) {
@@ -47,14 +227,35 @@ inline void Tracer::put_binary_unsigned (int64_t n) {
   assert (binary);
   assert (file);
   assert (n > 0);
-  unsigned char ch;
+  reserve (10);
+  unsigned char * p = (unsigned char *) block->pos;
   while (n & ~0x7f) {
-    ch = (n & 0x7f) | 0x80;
-    file->put (ch);
+    *p++ = (n & 0x7f) | 0x80;
     n >>= 7;
   }
-  ch = n;
-  file->put (ch);
+  *p++ = n;
+  block->pos = (char *) p;
+}
+
+// Delta encoded binary LRAT ('lratdelta') replaces absolute identifiers by
+// small differences.  The identifier of a derived clause is given relative
+// to the previously derived clause.  Hints and deleted identifiers are
+// encoded either absolute or relative to a base, whichever is smaller, with
+// the choice in the least significant bit of the magnitude, i.e., as the
+// signed number '2*|id| + 0' or '2*(base - |id|) + 1' with the sign of 'id'.
+// The base of a hint is the derived clause it justifies (hints refer to
+// earlier clauses).  The base of deleted identifiers is the last derived
+// clause plus one, which avoids relative zero (zero terminates lines).
+// Original clauses thus stay cheap as hints while recent clauses become
+// cheap too, even if identifiers are large as when interleaved across
+// instances.  Hints are not sorted, since their order determines unit
+// propagation when checking LRAT.
+
+inline void Tracer::put_binary_delta (clause_id_t base, clause_id_t id) {
+  assert (delta);
+  const int64_t a = abs (id), d = base - a;
+  const int64_t v = (0 < d && d < a) ? 2*d + 1 : 2*a;
+  put_binary_signed (id < 0 ? -v : v);
 }
 
 /*------------------------------------------------------------------------*/
@@ -64,18 +265,19 @@ void Tracer::add_original_clause (clause_id_t id, const vector<int> & clause) {
   if (file->closed ()) return;
   LOG ("TRACER tracing addition of original clause");
   //output o
-  if (binary) file->put ('o');
-  else file->put ("o ");
+  if (binary) put ('o');
+  else put ("o ");
   //output id
   if (binary) put_binary_unsigned (id);
-  else file->put (id), file->put ("  ");
+  else put (id), put ("  ");
   //output literals
   for (const auto & external_lit : clause)
     if (binary) put_binary_lit (external_lit);
-    else file->put (external_lit), file->put (' ');
+    else put (external_lit), put (' ');
   //output end line
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
+  end_line ();
 }
 
 
@@ -119,11 +321,14 @@ void Tracer::add_derived_clause (clause_id_t id, const vector<int64_t> * chain,
 
   LOG ("TRACER tracing addition of derived clause");
   //only FRAT files start lines with a
-  if ((lrat || frat) && binary) file->put ('a');
-  else if (frat) file->put ("a ");
+  if ((lrat || frat) && binary) put ('a');
+  else if (frat) put ("a ");
   //clause ID for FRAT or LRAT files
   if (binary){
-      if (lrat){
+      if (lrat && delta){
+          put_binary_signed(id - last_id);
+      }
+      else if (lrat){
           put_binary_signed(id);
       }
       else if (frat){
@@ -131,12 +336,12 @@ void Tracer::add_derived_clause (clause_id_t id, const vector<int64_t> * chain,
       }
   }
   else if (lrat || frat) {
-      file->put (id), file->put (" ");
+      put (id), put (" ");
   }
   //output literals for anything
   for (const auto & external_lit : clause){
     if (binary) put_binary_lit (external_lit);
-    else file->put (external_lit), file->put (' ');
+    else put (external_lit), put (' ');
   }
   //check if we have a chain, which is required for LRAT
   if (lrat && !chain){ //error if no proof for LRAT
@@ -146,20 +351,23 @@ void Tracer::add_derived_clause (clause_id_t id, const vector<int64_t> * chain,
   if ((frat || lrat) && chain) {
       //output end of literals before proof
       if (binary) put_binary_zero();
-      else file->put("0 ");
+      else put("0 ");
       //output FRAT proof hint marker
       if (frat){
-          if (binary) file->put ('l');
-          else file->put ("  l ");
+          if (binary) put ('l');
+          else put ("  l ");
       }
     for (const auto & c : *chain){
-      if (binary) put_binary_signed (c);
-      else file->put (c), file->put (' ');
+      if (delta) put_binary_delta (id, c);
+      else if (binary) put_binary_signed (c);
+      else put (c), put (' ');
     }
   }
   //end line:  0 ends proof (LRAT/FRAT) or literals (DRAT)
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
+  end_line ();
+  last_id = id;
   added++;
   //make sure the empty clause gets fully output here
   if (clause.size() == 0){
@@ -175,28 +383,30 @@ void Tracer::delete_clause (clause_id_t id, const vector<int> & clause) {
   LOG ("TRACER tracing deletion of clause");
   //output a leading, ignored clause ID for LRAT
   if (lrat && !binary){
-      file->put(id), file->put(" ");
+      put(id), put(" ");
   }
   //output the delete d for any format
-  if (binary) file->put ('d');
-  else file->put ("d ");
+  if (binary) put ('d');
+  else put ("d ");
   //output clause ID being deleted for LRAT or FRAT
   if (binary){
-      if (lrat) put_binary_signed(id);
+      if (lrat && delta) put_binary_delta (last_id + 1, id);
+      else if (lrat) put_binary_signed(id);
       else if (frat) put_binary_unsigned(id);
   }
   else if (lrat || frat) {
-    file->put (id), file->put (" ");
+    put (id), put (" ");
   }
   //output literals for FRAT or DRAT
   if (frat || !lrat){
       for (const auto & external_lit : clause)
           if (binary) put_binary_lit (external_lit);
-          else file->put (external_lit), file->put (' ');
+          else put (external_lit), put (' ');
   }
   //end the line with a zero
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
+  end_line ();
   deleted++;
 }
 
@@ -204,15 +414,16 @@ void Tracer::finalize_clause (clause_id_t id, const vector<int> & clause) {
   if (!frat) return; //only FRAT files contain finalize clauses
   if (file->closed ()) return;
   LOG ("TRACER tracing finalized clause");
-  if (binary) file->put ('f');
-  else file->put ("f ");
+  if (binary) put ('f');
+  else put ("f ");
   if (binary) put_binary_unsigned (id);
-  else file->put (id), file->put ("  ");
+  else put (id), put ("  ");
   for (const auto & external_lit : clause)
     if (binary) put_binary_lit (external_lit);
-    else file->put (external_lit), file->put (' ');
+    else put (external_lit), put (' ');
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
+  end_line ();
 }
 
 void Tracer::add_todo (const vector<int64_t> & vals) {
@@ -221,24 +432,41 @@ void Tracer::add_todo (const vector<int64_t> & vals) {
   ostringstream ss;
   for (auto c : vals) ss << " " << c;
   LOG ("TRACER tracing TODO%s", ss.str ().c_str ());
-  if (binary) file->put ('t');
-  else file->put ("t ");
+  if (binary) put ('t');
+  else put ("t ");
   for (const auto & val : vals)
     if (binary) put_binary_unsigned (val);
-    else file->put (val), file->put (' ');
+    else put (val), put (' ');
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
+  end_line ();
 }
 
 /*------------------------------------------------------------------------*/
 
 bool Tracer::closed () { return file->closed (); }
 
-void Tracer::close () { assert (!closed ()); file->close (); }
+void Tracer::close () {
+  assert (!closed ());
+  bool ok = write_block ();
+#ifndef NTHREADS
+  if (writer && !writer->wait ()) ok = false;
+#endif
+  delete writer;
+  writer = 0;
+  if (!file->flush ()) ok = false;
+  if (!ok) write_error ();
+  file->close ();
+}
 
 void Tracer::flush () {
   assert (!closed ());
-  file->flush ();
+  bool ok = write_block ();
+#ifndef NTHREADS
+  if (writer && !writer->wait ()) ok = false;
+#endif
+  if (!file->flush ()) ok = false;
+  if (!ok) write_error ();
   MSG ("traced %" PRId64 " added and %" PRId64 " deleted clauses",
     added, deleted);
 }
@@ -8,20 +8,48 @@
 
 namespace CaDiCaL {
 
+struct TracerWriter;
+
 class Tracer : public Observer {
 
   Internal * internal;
   File * file;
-  bool binary, lrat, frat, should_delete_clauses;
+  bool binary, lrat, frat, delta, should_delete_clauses;
+  clause_id_t last_id;          // last derived clause (for 'delta')
+
+  // Proof lines are encoded into the current block, which is written at
+  // the end of a line as soon as it holds 'block_size' bytes.  Blocks thus
+  // always end with complete lines.  If the proof is written asynchronously
+  // the full block is handed over to a background 'writer' thread and
+  // encoding continues in the other block.
+
+  struct Block { char * begin, * pos, * end; };
+  Block blocks[2], * block;
+  TracerWriter * writer;
+
+  void enlarge (size_t bytes);
+  void reserve (size_t bytes) {
+    if ((size_t) (block->end - block->pos) < bytes) enlarge (bytes);
+  }
+  bool write_block ();
+  void write_error ();
+  void end_line ();
+
+  void put (char ch) { reserve (1); *block->pos++ = ch; }
+  void put (const char *);
+  void put (int64_t);
+  void put (int lit) { put ((int64_t) lit); }
+
   void put_binary_zero ();
   void put_binary_lit (int external_lit);
   void put_binary_unsigned (int64_t n);
   void put_binary_signed (int64_t n);
+  void put_binary_delta (clause_id_t base, clause_id_t id);
   int64_t added, deleted;
 
 public:
 
-  Tracer (Internal *, File * file, bool binary, bool lrat, bool frat, bool delete_clauses); // own and delete 'file'
+  Tracer (Internal *, File * file, bool binary, bool lrat, bool frat, bool delete_clauses, bool async, bool delta); // own and delete 'file'
   ~Tracer ();
 
   void add_original_clause (clause_id_t, const vector<int> &);
@@ -8,6 +8,51 @@ namespace CaDiCaL {
 // binary clauses and is usually pretty fast.  It will also find some failed
 // literals (in the binary implication graph).
 
+// For LRAT proofs of failed literals we save for each reached literal the
+// binary clause through which it was reached first, i.e., the literal
+// 'parent' it was reached from and the identifier of the clause.  This
+// function adds the clauses on the path from 'src' to 'lit' to the chain
+// (in propagation order), but stops at literals already on a previously
+// added path, which are marked as 'justified'.
+
+struct TransredReason {
+  int parent;
+  clause_id_t id;
+};
+
+static void
+transred_path (Internal * internal, const TransredReason * reasons,
+               int src, int lit)
+{
+  vector<clause_id_t> & chain = internal->chain;
+  const size_t start = chain.size ();
+  while (lit != src) {
+    Flags & f = internal->flags (lit);
+    if (f.justified) break;
+    f.justified = true;
+    internal->justified.push_back (lit);
+    const TransredReason & reason = reasons[internal->vlit (lit)];
+    assert (reason.parent), assert (reason.id);
+    chain.push_back (reason.id);
+    lit = reason.parent;
+  }
+  reverse (chain.begin () + start, chain.end ());
+}
+
+// A binary clause is a candidate for being transitive if it is not the
+// result of hyper binary resolution.  The reason for excluding those, is
+// that they come in large numbers, most of them are reduced away anyhow
+// and further are non-transitive at the point they are added (see the code
+// in 'hyper_binary_resolve' in 'probe.cpp' and also check out our CPAIOR
+// paper on tree-based look ahead).  Binary clauses are visited through the
+// watch of their smaller literal, which also holds the 'transred' flag.
+
+static inline bool
+transred_candidate (int lit, const Binary & w) {
+  if (lit > w.blit) return false;
+  return !w.redundant || !w.hyper;
+}
+
 void Internal::transred () {
 
   if (unsat) return;
@@ -32,152 +77,161 @@ void Internal::transred () {
   PHASE ("transred", stats.transreds,
     "transitive reduction limit of %" PRId64 " propagations", limit);
 
-  const auto end = clauses.end ();
-  auto i = clauses.begin ();
-
-  // Find first clause not checked for being transitive yet.
+  // Check whether there are binary clauses not checked for being
+  // transitive yet.  If all candidate clauses have been checked
+  // reschedule all.
   //
-  for (; i != end; i++) {
-    Clause * c = *i;
-    if (c->garbage) continue;
-    if (c->size != 2) continue;
-    if (c->redundant && c->hyper) continue;
-    if (!c->transred) break;
+  bool unchecked = false;
+  for (auto lit : lits) {
+    for (const auto & w : binary_watches (lit))
+      if (transred_candidate (lit, w) && !w.transred) {
+        unchecked = true;
+        break;
+      }
+    if (unchecked) break;
   }
 
-  // If all candidate clauses have been checked reschedule all.
-  //
-  if (i == end) {
-
+  if (!unchecked) {
     PHASE ("transred", stats.transreds,
       "rescheduling all clauses since no clauses to check left");
-    for (i = clauses.begin (); i != end; i++) {
-      Clause * c = *i;
-      if (c->transred) c->transred = false;
-    }
-    i = clauses.begin ();
+    for (auto lit : lits)
+      for (auto & w : binary_watches (lit))
+        w.transred = false;
   }
 
-  // Move watches of binary clauses to the front. Thus we can stop iterating
-  // watches as soon a long clause is found during watch traversal.
-  //
-  sort_watches ();
-
   // This working stack plays the same role as the 'trail' during standard
   // propagation.
   //
   vector<int> work;
 
+  const bool lrat = proof && opts.lrat;
+  TransredReason * reasons = 0;
+  if (lrat) {
+    const size_t size_reasons = 2*(1 + (size_t) max_var);
+    reasons = new TransredReason [size_reasons];
+    clear_n (reasons, size_reasons);
+  }
+
   int64_t propagations = 0, units = 0, removed = 0;
 
-  while (!unsat &&
-         i != end &&
-         !terminated_asynchronously () &&
-         propagations < limit)
-  {
-    Clause * c = *i++;
-
-    // A clause is a candidate for being transitive if it is binary, and not
-    // the result of hyper binary resolution.  The reason for excluding
-    // those, is that they come in large numbers, most of them are reduced
-    // away anyhow and further are non-transitive at the point they are
-    // added (see the code in 'hyper_binary_resolve' in 'prope.cpp' and
-    // also check out our CPAIOR paper on tree-based look ahead).
-    //
-    if (c->garbage) continue;
-    if (c->size != 2) continue;
-    if (c->redundant && c->hyper) continue;
-    if (c->transred) continue;                  // checked before?
-    c->transred = true;                         // marked as checked
-
-    LOG (c, "checking transitive reduction of");
-
-    // Find a different path from 'src' to 'dst' in the binary implication
-    // graph, not using 'c'.  Since this is the same as checking whether
-    // there is a path from '-dst' to '-src', we can do the reverse search
-    // if the number of watches of '-dst' is larger than those of 'src'.
-    //
-    int src = -c->literals[0];
-    int dst = c->literals[1];
-    if (val (src) || val (dst)) continue;
-    if (watches (-src).size () < watches (dst).size ()) {
-      int tmp = dst;
-      dst = -src; src = -tmp;
-    }
+  for (auto first : lits) {
 
-    LOG ("searching path from %d to %d", src, dst);
+    if (unsat) break;
+    if (terminated_asynchronously ()) break;
+    if (propagations >= limit) break;
 
-    // If the candidate clause is irredundant then we can not use redundant
-    // binary clauses in the implication graph.  See our inprocessing rules
-    // paper, why this restriction is required.
+    // The watches of 'first' might be removed while we iterate over them,
+    // thus we can not use iterators here.
     //
-    const bool irredundant = !c->redundant;
-
-    assert (work.empty ());
-    mark (src);
-    work.push_back (src);
-    LOG ("transred assign %d", src);
-
-    bool transitive = false;            // found path from 'src' to 'dst'?
-    bool failed = false;                // 'src' failed literal?
-
-    size_t j = 0;                       // 'propagated' in BFS
-
-    while (!transitive && !failed && j < work.size ()) {
-      const int lit = work[j++];
-      assert (marked (lit) > 0);
-      LOG ("transred propagating %d", lit);
-      propagations++;
-      const Watches & ws = watches (-lit);
-      const const_watch_iterator eow = ws.end ();
-      const_watch_iterator k;
-      for (k = ws.begin (); !transitive && !failed && k != eow; k++) {
-        const Watch & w = *k;
-        if (!w.binary ()) break;        // since we sorted watches above
-        Clause * d = w.clause;
-        if (d == c) continue;
-        if (irredundant && d->redundant) continue;
-        if (d->garbage) continue;
-        const int other = w.blit;
-        if (other == dst) transitive = true;    // 'dst' reached
-        else {
-          const int tmp = marked (other);
-          if (tmp > 0) continue;
-          else if (tmp < 0) {
-            LOG ("found both %d and %d reachable", -other, other);
-            failed = true;
-          } else {
-            mark (other);
-            work.push_back (other);
-            LOG ("transred assign %d", other);
+    size_t i = 0;
+    while (!unsat && i < binary_watches (first).size () &&
+           propagations < limit) {
+
+      Binary & cw = binary_watches (first)[i++];
+      if (!transred_candidate (first, cw)) continue;
+      if (cw.transred) continue;                // checked before?
+      cw.transred = true;                       // marked as checked
+      const Binary c = cw;
+
+      LOG ("checking transitive reduction of binary clause %d %d",
+        first, c.blit);
+
+      // Find a different path from 'src' to 'dst' in the binary
+      // implication graph, not using 'c'.  Since this is the same as
+      // checking whether there is a path from '-dst' to '-src', we can do
+      // the reverse search if the number of watches of '-dst' is larger
+      // than those of 'src'.
+      //
+      int src = -first;
+      int dst = c.blit;
+      if (val (src) || val (dst)) continue;
+      if (binary_watches (-src).size () < binary_watches (dst).size ()) {
+        int tmp = dst;
+        dst = -src; src = -tmp;
+      }
+
+      LOG ("searching path from %d to %d", src, dst);
+
+      // If the candidate clause is irredundant then we can not use
+      // redundant binary clauses in the implication graph.  See our
+      // inprocessing rules paper, why this restriction is required.
+      //
+      const bool irredundant = !c.redundant;
+
+      assert (work.empty ());
+      mark (src);
+      work.push_back (src);
+      LOG ("transred assign %d", src);
+
+      bool transitive = false;          // found path from 'src' to 'dst'?
+      bool failed = false;              // 'src' failed literal?
+
+      size_t j = 0;                     // 'propagated' in BFS
+
+      while (!transitive && !failed && j < work.size ()) {
+        const int lit = work[j++];
+        assert (marked (lit) > 0);
+        LOG ("transred propagating %d", lit);
+        propagations++;
+        const Binaries & ws = binary_watches (-lit);
+        const const_binary_iterator eow = ws.end ();
+        const_binary_iterator k;
+        for (k = ws.begin (); !transitive && !failed && k != eow; k++) {
+          const Binary & w = *k;
+          const int other = w.blit;
+          if (lit == src && other == dst && w.mirrors (c)) continue;
+          if (irredundant && w.redundant) continue;
+          if (other == dst) transitive = true;  // 'dst' reached
+          else {
+            const int tmp = marked (other);
+            if (tmp > 0) continue;
+            else if (tmp < 0) {
+              LOG ("found both %d and %d reachable", -other, other);
+              failed = true;
+              if (lrat) {
+                transred_path (this, reasons, src, -other);
+                transred_path (this, reasons, src, lit);
+                chain.push_back (binary_id (w));
+                for (const auto & tmp : justified)
+                  flags (tmp).justified = false;
+                justified.clear ();
+              }
+            } else {
+              if (lrat) reasons[vlit (other)] = { lit, binary_id (w) };
+              mark (other);
+              work.push_back (other);
+              LOG ("transred assign %d", other);
+            }
           }
         }
       }
-    }
 
-    // Unassign all assigned literals (same as '[bp]acktrack').
-    //
-    while (!work.empty ()) {
-      const int lit = work.back ();
-      work.pop_back ();
-      unmark (lit);
-    }
+      // Unassign all assigned literals (same as '[bp]acktrack').
+      //
+      while (!work.empty ()) {
+        const int lit = work.back ();
+        work.pop_back ();
+        unmark (lit);
+        if (lrat) reasons[vlit (lit)].parent = 0;
+      }
 
-    if (transitive) {
-      removed++;
-      stats.transitive++;
-      LOG (c, "transitive redundant");
-      mark_garbage (c);
-    } else if (failed) {
-      units++;
-      LOG ("found failed literal %d during transitive reduction", src);
-      stats.failed++;
-      stats.transredunits++;
-      PROOF_TODO (proof, "transitive reduction unit", 90); // TODO(Mario)
-      assign_unit (-src);
-      if (!propagate ()) {
-        VERBOSE (1, "propagating new unit results in conflict");
-        learn_empty_clause ();
+      if (transitive) {
+        removed++;
+        stats.transitive++;
+        LOG ("transitive redundant binary clause %d %d", first, c.blit);
+        delete_binary_clause (first, c);
+        i--;
+      } else if (failed) {
+        units++;
+        LOG ("found failed literal %d during transitive reduction", src);
+        stats.failed++;
+        stats.transredunits++;
+        assign_unit (-src);
+        if (!propagate ()) {
+          VERBOSE (1, "propagating new unit results in conflict");
+          build_chain ();
+          learn_empty_clause ();
+        }
       }
     }
   }
@@ -185,6 +239,7 @@ void Internal::transred () {
   last.transred.propagations = stats.propagations.search;
   stats.propagations.transred += propagations;
   erase_vector (work);
+  if (reasons) delete [] reasons;
 
   PHASE ("transred", stats.transreds,
     "removed %" PRId64 " transitive clauses, found %" PRId64 " units",
@@ -22,10 +22,32 @@ struct Var {
 
   };
 
-  // ID of the unit clause corresponding to this variable
-  clause_id_t unit_id;
+  union {
+
+    clause_id_t unit_id;   // ID of the unit clause (on the root-level)
+    clause_id_t binary_id; // ID of a binary reason (if proofs traced)
+
+  };
 };
 
+// The reason of a literal implied by a binary clause is the other literal
+// of that clause tagged as clause pointer with the least significant bit
+// set, since binary clauses are not allocated (see 'watch.hpp').  Tagged
+// reasons can not be dereferenced.
+
+inline Clause * binary_reason (int other) {
+  return (Clause *) (2 * (intptr_t) other + 1);
+}
+
+inline bool is_binary_reason (const Clause * reason) {
+  return (uintptr_t) reason & 1;
+}
+
+inline int binary_reason_literal (const Clause * reason) {
+  assert (is_binary_reason (reason));
+  return (int) (((intptr_t) reason - 1) / 2);
+}
+
 }
 
 #endif
@@ -44,9 +44,11 @@ namespace CaDiCaL {
 // assignment procedure 'vivify_assign', which does not mess with phase
 // saving during search nor the conflict and other statistics and further
 // can be inlined separately here.  The propagation routine needs to ignore
-// (large) clauses which are currently vivified.
+// (large) clauses which are currently vivified.  Redundant binary clauses
+// are always watched and thus skipped in irredundant mode.
 
-inline void Internal::vivify_assign (int lit, Clause * reason) {
+inline void
+Internal::vivify_assign (int lit, Clause * reason, clause_id_t id) {
   require_mode (VIVIFY);
   const int idx = vidx (lit);
   assert (!vals[idx]);
@@ -55,7 +57,9 @@ inline void Internal::vivify_assign (int lit, Clause * reason) {
   v.level = level;                      // required to reuse decisions
   v.trail = (int) trail.size ();        // used in 'vivify_better_watch'
   v.reason = level ? reason : 0;        // for conflict analysis
-  if (!level) {
+  if (level) v.binary_id = id;
+  else {
+    reason = reason_clause (lit, reason, id);
     if (proof && reason) {
       for (const_literal_iterator l = reason->begin (); l != reason->end (); l++) {
         const int lit2 = *l;
@@ -93,7 +97,7 @@ void Internal::vivify_assume (int lit) {
 // 'probe_propagate' with 'probe_propagate2' in 'probe.cpp'.  Please refer
 // to that code for more explanation on how propagation is implemented.
 
-bool Internal::vivify_propagate () {
+bool Internal::vivify_propagate (bool redundant_mode) {
   require_mode (VIVIFY);
   assert (!unsat);
   START (propagate);
@@ -102,13 +106,15 @@ bool Internal::vivify_propagate () {
     if (propagated2 != trail.size ()) {
       const int lit = -trail[propagated2++];
       LOG ("vivify propagating %d over binary clauses", -lit);
-      Watches & ws = watches (lit);
-      for (const auto & w : ws) {
-        if (!w.binary ()) continue;
+      for (const auto & w : binary_watches (lit)) {
+        if (w.redundant && !redundant_mode) continue;
         const signed char b = val (w.blit);
         if (b > 0) continue;
-        if (b < 0) conflict = w.clause;                 // but continue
-        else vivify_assign (w.blit, w.clause);
+        if (b < 0)                                        // but continue
+          conflict = binary_clause (&binary_conflict_clause,
+                                    lit, w.blit, binary_id (w), w.redundant);
+        else
+          vivify_assign (w.blit, binary_reason (lit), binary_id (w));
       }
     } else if (!conflict && propagated != trail.size ()) {
       const int lit = -trail[propagated++];
@@ -119,18 +125,18 @@ bool Internal::vivify_propagate () {
       watch_iterator j = ws.begin ();
       while (i != eow) {
         const Watch w = *j++ = *i++;
-        if (w.binary ()) continue;
         if (val (w.blit) > 0) continue;
-        if (w.clause->garbage) { j--; continue; }
-        if (w.clause == ignore) continue;
-        literal_iterator lits = w.clause->begin ();
+        Clause * c = watched (w);
+        if (c->garbage) { j--; continue; }
+        if (c == ignore) continue;
+        literal_iterator lits = c->begin ();
         const int other = lits[0]^lits[1]^lit;
         const signed char u = val (other);
         if (u > 0) j[-1].blit = other;
         else {
-          const int size = w.clause->size;
+          const int size = c->size;
           const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
+          const literal_iterator middle = lits + c->pos;
           literal_iterator k = middle;
           signed char v = -1;
           int r = 0;
@@ -138,27 +144,27 @@ bool Internal::vivify_propagate () {
             k++;
           if (v < 0) {
             k = lits + 2;
-            assert (w.clause->pos <= size);
+            assert (c->pos <= size);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+          c->pos = k - lits;
+          assert (lits + 2 <= k), assert (k <= c->end ());
           if (v > 0) j[-1].blit = r;
           else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
+            LOG (c, "unwatch %d in", r);
             lits[0] = other;
             lits[1] = r;
             *k = lit;
-            watch_literal (r, lit, w.clause);
+            watch_literal (r, lit, c);
             j--;
           } else if (!u) {
             assert (v < 0);
-            vivify_assign (other, w.clause);
+            vivify_assign (other, c);
           } else {
             assert (u < 0);
             assert (v < 0);
-            conflict = w.clause;
+            conflict = c;
             break;
           }
         }
@@ -377,22 +383,28 @@ void Internal::vivify_analyze_redundant (Vivifier & vivifier,
   auto & stack = vivifier.stack;
   stack.clear ();
 
+  auto analyze = [&] (int lit) {
+    Var & v = var (lit);
+    if (!v.level) return;
+    Flags & f = flags (lit);
+    if (f.seen) return;
+    assert (val (lit) < 0);
+    f.seen = true;
+    analyzed.push_back (lit);
+    if (v.reason) stack.push_back (v.reason);
+    else LOG ("vivify seen %d", lit);
+  };
+
   stack.push_back (start);
   while (!stack.empty ()) {
     Clause * c = stack.back ();
-    if (c->size > 2) only_binary_reasons = false;
     stack.pop_back ();
     LOG (c, "vivify analyze");
-    for (const auto & lit : *c) {
-      Var & v = var (lit);
-      if (!v.level) continue;
-      Flags & f = flags (lit);
-      if (f.seen) continue;
-      assert (val (lit) < 0);
-      f.seen = true;
-      analyzed.push_back (lit);
-      if (v.reason) stack.push_back (v.reason);
-      else LOG ("vivify seen %d", lit);
+    if (is_binary_reason (c)) analyze (binary_reason_literal (c));
+    else {
+      if (c->size > 2) only_binary_reasons = false;
+      for (const auto & lit : *c)
+        analyze (lit);
     }
   }
 
@@ -487,13 +499,14 @@ struct vivify_better_watch {
 };
 
 // Common code to actually strengthen a candidate clause.  The resulting
-// strengthened clause is communicated through the global 'clause'.
+// strengthened clause is communicated through the global 'clause'.  Its
+// LRAT chain has to be built before (while the implication graph which
+// justifies the strengthening is still on the trail).
 
 void Internal::vivify_strengthen (Clause * c) {
 
   assert (!clause.empty ());
   stats.vivifystrs++;
-  PROOF_TODO (proof, "vivify strengthen", 101); // TODO(Mario)
 
   if (clause.size () == 1) {
 
@@ -507,6 +520,7 @@ void Internal::vivify_strengthen (Clause * c) {
 
     bool ok = propagate ();
     if (!ok) {
+      build_chain ();
       learn_empty_clause ();
     }
 
@@ -745,7 +759,10 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
           vivify_analyze_redundant (vivifier, v.reason, only_binary_reasons);
           if (!only_binary_reasons) {
             vivify_post_process_analysis (c, subsume);
-            if (!clause.empty ()) stats.vivifystred2++;
+            if (!clause.empty ()) {
+              build_chain (clause, reason_clause (lit));
+              stats.vivifystred2++;
+            }
           }
           clear_analyzed_literals ();
 
@@ -769,7 +786,7 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
       vivify_assume (-lit);
       LOG ("negated decision %d score %" PRId64 "", lit, noccs (lit));
 
-      if (vivify_propagate ()) continue;        // hot-spot
+      if (vivify_propagate (redundant_mode)) continue;    // hot-spot
 
       LOG ("subsumed since propagation produced conflict");
 
@@ -786,7 +803,10 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
         vivify_analyze_redundant (vivifier, conflict, only_binary_reasons);
         if (!only_binary_reasons) {
           vivify_post_process_analysis (c, subsume);
-          if (!clause.empty ()) stats.vivifystred3++;
+          if (!clause.empty ()) {
+            build_chain (clause, conflict);
+            stats.vivifystred3++;
+          }
         }
         clear_analyzed_literals ();
       }
@@ -871,6 +891,7 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
     if (redundant_mode) stats.vivifystred1++;
     else                stats.vivifystrirr++;
 
+    build_chain (clause, c);
     vivify_strengthen (c);
 
   } else {
@@ -925,6 +946,12 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
       noccs (lit) += score;
   }
 
+  for (auto lit : lits)
+    for (const auto & w : binary_watches (lit)) {
+      if (w.redundant != redundant_mode) continue;
+      noccs (lit) += 1l << 10;
+    }
+
   // Refill the schedule every time.  Unchecked clauses are 'saved' by
   // setting their 'vivify' bit, such that they can be tried next time.
   //
@@ -986,6 +1013,7 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
 
   if (!unsat && !propagate ()) {
     LOG ("propagation after connecting watches in inconsistency");
+    build_chain ();
     learn_empty_clause ();
   }
 
@@ -1042,6 +1070,7 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
 
     if (!propagate ()) {
       LOG ("propagating vivified units leads to conflict");
+      build_chain ();
       learn_empty_clause ();
     }
   }
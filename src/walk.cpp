@@ -125,9 +125,8 @@ unsigned Internal::walk_break_value (int lit) {
   for (auto & w : watches (lit)) {
     assert (w.blit != lit);
     if (val (w.blit) > 0) continue;
-    if (w.binary ()) { res++; continue; }
 
-    Clause * c = w.clause;
+    Clause * c = watched (w);
     assert (lit == c->literals[0]);
 
     // Now try to find a second satisfied literal starting at 'literals[1]'
@@ -335,7 +334,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
     LOG ("trying to brake %zd watched clauses", ws.size ());
 
     for (const auto w : ws) {
-      Clause * d = w.clause;
+      Clause * d = watched (w);
       LOG (d, "unwatch %d in", -lit);
       int * literals = d->literals, replacement = 0, prev = -lit;
       assert (literals[0] == -lit);
@@ -408,6 +407,11 @@ int Internal::walk_round (int64_t limit, bool prev) {
   if (last.collect.fixed < stats.all.fixed)
     garbage_collection ();
 
+  // Local search works on clauses in a one-watch scheme and thus needs
+  // binary clauses to be allocated as clauses too.
+  //
+  make_binaries_explicit ();
+
 #ifndef QUIET
   // We want to see more messages during initial local search.
   //
@@ -642,6 +646,7 @@ int Internal::walk_round (int64_t limit, bool prev) {
   level = 0;
 
   clear_watches ();
+  make_binaries_implicit ();
   connect_watches ();
 
 #ifndef QUIET
@@ -2,10 +2,14 @@
 
 namespace CaDiCaL {
 
+// The watch table itself is kept, since the binary watches are the only
+// representation of binary clauses (see 'watch.hpp').  Only the watches of
+// larger clauses are initialized, cleared or reset here.
+
 void Internal::init_watches () {
-  assert (wtab.empty ());
-  while (wtab.size () < 2*vsize)
-    wtab.push_back (Watches ());
+  assert (!watching_clauses);
+  assert (wtab.size () >= 2*vsize);
+  watching_clauses = true;
   LOG ("initialized watcher tables");
 }
 
@@ -15,8 +19,10 @@ void Internal::clear_watches () {
 }
 
 void Internal::reset_watches () {
-  assert (!wtab.empty ());
-  erase_vector (wtab);
+  assert (watching_clauses);
+  for (auto lit : lits)
+    erase_vector (watches (lit));
+  watching_clauses = false;
   LOG ("reset watcher tables");
 }
 
@@ -29,13 +35,14 @@ void Internal::connect_watches (bool irredundant_only) {
 
   LOG ("watching all %sclauses", irredundant_only ? "irredundant " : "");
 
-  // First connect binary clauses.
+  // First connect explicit binary clauses.
   //
-  for (const auto & c : clauses) {
-    if (irredundant_only && c->redundant) continue;
-    if (c->garbage || c->size > 2) continue;
-    watch_clause (c);
-  }
+  if (explicit_binaries)
+    for (const auto & c : clauses) {
+      if (irredundant_only && c->redundant) continue;
+      if (c->garbage || c->size > 2) continue;
+      watch_clause (c);
+    }
 
   // Then connect non-binary clauses.
   //
@@ -70,31 +77,4 @@ void Internal::connect_watches (bool irredundant_only) {
   STOP (connect);
 }
 
-void Internal::sort_watches () {
-  assert (watching ());
-  LOG ("sorting watches");
-  Watches saved;
-  for (auto lit : lits) {
-    Watches & ws = watches (lit);
-
-    const const_watch_iterator end = ws.end ();
-    watch_iterator j = ws.begin ();
-    const_watch_iterator i;
-
-    assert (saved.empty ());
-
-    for (i = j; i != end; i++) {
-      const Watch w = *i;
-      if (w.binary ()) *j++ = w;
-      else saved.push_back (w);
-    }
-    ws.resize (j - ws.begin ());
-
-    for (const auto & w : saved)
-      ws.push_back (w);
-
-    saved.clear ();
-  }
-}
-
 }
@@ -9,40 +9,92 @@ namespace CaDiCaL {
 // Watch lists for CDCL search.  The blocking literal (see also comments
 // related to 'propagate') is a must and thus combining that with a 64 bit
 // pointer will give a 16 byte (8 byte aligned) structure anyhow, which
-// means the additional 4 bytes for the size come for free.  As alternative
+// means the additional 4 bytes come for free.  They are used to store the
+// third literal of ternary clauses, which serves as second blocking
+// literal and is zero for larger clauses.  As alternative
 // one could use a 32-bit reference instead of the pointer which would
 // however limit the number of clauses to '2^32 - 1'.  One would also need
 // to use at least one more bit (either taken away from the variable space
 // or the clauses) to denote whether the watch is binary.
 
+// This alternative is used if compiled with '-DCOMPACTWATCHES' (configure
+// with '--compact-watches').  Then all clauses are kept in the arena (see
+// 'arena.hpp') and 'ref' is the offset of the clause in the arena in 8
+// byte words, which halves the size of watches to 8 bytes.  The referenced
+// clause is obtained with 'Internal::watched' and watches are created with
+// 'Internal::new_watch' which both need access to the arena.
+
 struct Clause;
 
+#ifdef COMPACTWATCHES
+
 struct Watch {
 
-  Clause * clause; int blit;
-  int size;
+  unsigned ref; int blit;
 
-  Watch (int b, Clause * c) : clause (c), blit (b), size (c->size) { }
+  Watch (int b, unsigned r) : ref (r), blit (b) { }
   Watch () { }
+};
+
+#else
+
+struct Watch {
 
-  bool binary () const { return size == 2; }
+  Clause * clause; int blit;
+  int tern;
+
+  Watch (int b, Clause * c, int t) : clause (c), blit (b), tern (t) { }
+  Watch () { }
 };
 
+#endif
+
 typedef vector<Watch> Watches;          // of one literal
 
+// Binary clauses are not allocated as 'Clause' but only exist implicitly
+// as two 'Binary' watches, one in the binary watch list of each of their
+// literals, with the other literal as 'blit'.  Both watches carry the same
+// flags.  Clause identifiers are only needed for proofs and thus 'ref' is
+// zero unless proofs are traced.  Then it refers to the identifier of the
+// clause in 'Internal::binary_ids' (see 'binary.cpp').  A binary reason is
+// tagged with its other literal instead of pointing to a clause (see
+// 'binary_reason' in 'var.hpp').  Only bounded variable elimination and
+// globally blocked clause elimination, which work on clauses in occurrence
+// lists, temporarily allocate binary clauses as 'Clause' again (see
+// 'make_binaries_explicit').  Keeping both watch lists of a literal next to
+// each other in the watch table makes it likely that their headers share a
+// cache line during propagation.
+
+struct Binary {
+
+  int blit;                     // other literal of the clause
+  unsigned redundant:1;         // aka 'learned'
+  unsigned hyper:1;             // redundant hyper binary resolvent
+  unsigned transred:1;          // checked in 'transred' (smaller literal)
+  unsigned ref:29;              // identifier reference (if proofs traced)
+
+  Binary (int b, bool r, bool h, unsigned i) :
+    blit (b), redundant (r), hyper (h), transred (0), ref (i) { }
+  Binary () { }
+
+  // The two watches of the same binary clause (ignoring 'transred').
+
+  bool mirrors (const Binary & w) const {
+    return ref == w.ref && redundant == w.redundant && hyper == w.hyper;
+  }
+};
+
+const unsigned max_binary_ref = (1u << 29) - 1;
+
+typedef vector<Binary> Binaries;        // of one literal
+
+struct WatchLists { Binaries binary; Watches large; };
+
 typedef Watches::iterator watch_iterator;
 typedef Watches::const_iterator const_watch_iterator;
 
-inline void remove_watch (Watches & ws, Clause * clause) {
-  const auto end = ws.end ();
-  auto i = ws.begin ();
-  for (auto j = i; j != end; j++) {
-    const Watch & w = *i++ = *j;
-    if (w.clause == clause) i--;
-  }
-  assert (i + 1 == end);
-  ws.resize (i - ws.begin ());
-}
+typedef Binaries::iterator binary_iterator;
+typedef Binaries::const_iterator const_binary_iterator;
 
 }
 
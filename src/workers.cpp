@@ -0,0 +1,109 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+#ifndef NTHREADS
+
+Workers::Workers ()
+:
+  job (0), active (0), generation (0), running (0), stop (false),
+  busy (0), wall (0)
+{ }
+
+Workers::~Workers () { stop_threads (); }
+
+void Workers::stop_threads () {
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    stop = true;
+  }
+  started.notify_all ();
+  for (auto & thread : threads)
+    thread.join ();
+  threads.clear ();
+  stop = false;
+}
+
+void Workers::reserve (unsigned workers) {
+  if (workers <= size ()) return;
+  times.resize (workers);
+  for (unsigned i = size (); i < workers; i++)
+    threads.emplace_back (&Workers::work, this, i, generation);
+}
+
+// Threads wait for a new job, i.e., a new 'generation', starting with the
+// one at the point they were started by 'reserve'.
+
+void Workers::work (unsigned worker, uint64_t seen) {
+  for (;;) {
+    const std::function<void (unsigned)> * current;
+    bool working;
+    {
+      std::unique_lock<std::mutex> lock (mutex);
+      while (!stop && generation == seen)
+        started.wait (lock);
+      if (stop) return;
+      seen = generation;
+      current = job;
+      working = worker < active;
+    }
+    if (working) {
+      const double start = absolute_real_time ();
+      (*current) (worker);
+      times[worker] = absolute_real_time () - start;
+    }
+    {
+      std::lock_guard<std::mutex> lock (mutex);
+      if (!--running) finished.notify_one ();
+    }
+  }
+}
+
+void Workers::run (unsigned workers,
+                   const std::function<void (unsigned)> & f) {
+  assert (workers > 0), assert (workers <= size ());
+  const double start = absolute_real_time ();
+  if (workers == 1) {
+    f (0);
+    const double delta = absolute_real_time () - start;
+    busy += delta, wall += delta;
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    job = &f;
+    active = workers;
+    running = threads.size ();
+    generation++;
+  }
+  started.notify_all ();
+  f (0);
+  times[0] = absolute_real_time () - start;
+  {
+    std::unique_lock<std::mutex> lock (mutex);
+    while (running)
+      finished.wait (lock);
+    job = 0;
+  }
+  wall += absolute_real_time () - start;
+  for (unsigned i = 0; i < workers; i++)
+    busy += times[i];
+}
+
+#else
+
+Workers::Workers () : busy (0), wall (0) { }
+Workers::~Workers () { }
+
+void Workers::reserve (unsigned) { }
+
+void Workers::run (unsigned, const std::function<void (unsigned)> & f) {
+  const double start = absolute_real_time ();
+  f (0);
+  const double delta = absolute_real_time () - start;
+  busy += delta, wall += delta;
+}
+
+#endif
+
+}
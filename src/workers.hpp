@@ -0,0 +1,71 @@
+#ifndef _workers_hpp_INCLUDED
+#define _workers_hpp_INCLUDED
+
+#include <functional>
+
+#ifndef NTHREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace CaDiCaL {
+
+// Flushing watches and copying clauses in the moving garbage collector are
+// embarrassingly parallel over literals and clauses, and thus optionally
+// (if 'opts.collectthreads' is larger than one) run by this pool of worker
+// threads, which is also used for checking elimination candidates in
+// parallel ('opts.elimthreads').  The threads are started by 'reserve' and
+// then wait for the next job given to 'run', which the calling thread joins
+// as worker zero.  Without thread support ('NTHREADS') there is only the
+// calling thread.
+
+// The time spent by all workers and the elapsed time of all 'run' calls are
+// accumulated in 'busy' and 'wall' respectively, which gives the speedup.
+
+class Workers {
+
+#ifndef NTHREADS
+  vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable started, finished;
+  const std::function<void (unsigned)> * job;
+  unsigned active;              // number of workers calling 'job'
+  vector<double> times;         // busy time of each worker in 'run'
+  uint64_t generation;          // incremented for each job
+  unsigned running;             // number of threads still working on job
+  bool stop;
+
+  void work (unsigned worker, uint64_t seen);
+  void stop_threads ();
+#endif
+
+public:
+
+  double busy, wall;
+
+  Workers ();
+  ~Workers ();
+
+  // Make sure there are at least that many workers (including the calling
+  // thread) unless there is no thread support.
+  //
+  void reserve (unsigned workers);
+
+  unsigned size () const {
+#ifndef NTHREADS
+    return threads.size () + 1;
+#else
+    return 1;
+#endif
+  }
+
+  // Call 'job (worker)' for each 'worker < workers' in parallel and wait
+  // until all of them finished, where 'workers' should be at most 'size ()'.
+  //
+  void run (unsigned workers, const std::function<void (unsigned)> & job);
+};
+
+}
+
+#endif
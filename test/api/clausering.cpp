@@ -0,0 +1,116 @@
+#include "../../src/clausering.hpp"
+
+#include <iostream>
+
+#ifndef NTHREADS
+#include <thread>
+#endif
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+extern "C" {
+#include <assert.h>
+}
+
+// Share clauses through rings, first sequentially, with one solver
+// exporting whole clauses and one connected as learner, then between
+// solvers running concurrently in their own threads.
+
+static void formula (CaDiCaL::Solver & solver) {
+  for (int r = -1; r < 2; r += 2)
+    for (int s = -1; s < 2; s += 2)
+      for (int t = -1; t < 2; t += 2)
+	solver.add (r * 1), solver.add (s * 2), solver.add (t * 3),
+	solver.add (0);
+}
+
+static void pigeon_hole (CaDiCaL::Solver & solver, int holes) {
+  const int pigeons = holes + 1;
+  for (int p = 0; p < pigeons; p++) {
+    for (int h = 0; h < holes; h++)
+      solver.add (p * holes + h + 1);
+    solver.add (0);
+  }
+  for (int h = 0; h < holes; h++)
+    for (int p = 0; p < pigeons; p++)
+      for (int q = p + 1; q < pigeons; q++)
+	solver.add (-(p * holes + h + 1)), solver.add (-(q * holes + h + 1)),
+	solver.add (0);
+}
+
+int main () {
+  {
+    CaDiCaL::Solver ping, pong, pang;
+    ping.set ("instance_num", 1), ping.set ("total_instances", 3);
+    pong.set ("instance_num", 2), pong.set ("total_instances", 3);
+    pang.set ("instance_num", 3), pang.set ("total_instances", 3);
+    CaDiCaL::ClauseRing ping_ring, pong_ring, tiny_ring (8);
+    CaDiCaL::ClauseRingReader reader, tiny_reader;
+    reader.connect (&ping_ring), reader.connect (&pong_ring);
+    tiny_reader.connect (&tiny_ring);
+    ping.connect_clause_exporter (&ping_ring, 2);
+    pong.connect_learner (&pong_ring);
+    formula (ping), formula (pong), formula (pang);
+    int a = ping.solve ();
+    ping.disconnect_clause_exporter ();
+    int b = pong.solve ();
+    std::cout << "ping returns " << a << " after publishing "
+              << ping_ring.clauses << " clauses" << std::endl;
+    std::cout << "pong returns " << b << " after publishing "
+              << pong_ring.clauses << " clauses" << std::endl;
+    assert (ping_ring.clauses > 0);
+    pang.connect_learn_source (&reader);
+    int c = pang.solve ();
+    std::cout << "pang returns " << c << " after reading "
+              << reader.clauses << " clauses" << std::endl;
+    assert (reader.clauses == ping_ring.clauses + pong_ring.clauses);
+    assert (!reader.lost);
+    assert (a == b), assert (a == c), assert (a == 20);
+
+    // Overwritten records are lost for readers falling behind.
+    //
+    const int unit[] = { 3, 4, 0, 1 };
+    for (int i = 0; i < 3; i++) tiny_ring.publish (unit);
+    assert (!tiny_reader.hasNextClause ());
+    assert (tiny_reader.lost == 1);
+    tiny_ring.publish (unit);
+    assert (tiny_reader.hasNextClause ());
+    assert (tiny_reader.getNextClause ().size () == 3);
+    assert (!tiny_reader.hasNextClause ());
+  }
+#ifndef NTHREADS
+  {
+    const int n = 3;
+    CaDiCaL::Solver solvers[n];
+    CaDiCaL::ClauseRing rings[n];
+    CaDiCaL::ClauseRingReader readers[n];
+    int results[n];
+    for (int i = 0; i < n; i++) {
+      solvers[i].set ("instance_num", i + 1);
+      solvers[i].set ("total_instances", n);
+      solvers[i].set ("seed", i);
+      solvers[i].connect_clause_exporter (&rings[i], 4);
+      for (int j = 0; j < n; j++)
+        if (j != i) readers[i].connect (&rings[j]);
+      solvers[i].connect_learn_source (&readers[i]);
+      pigeon_hole (solvers[i], 6);
+    }
+    std::thread threads[n];
+    for (int i = 0; i < n; i++)
+      threads[i] = std::thread ([&solvers, &results, i] () {
+        results[i] = solvers[i].solve ();
+      });
+    for (int i = 0; i < n; i++) {
+      threads[i].join ();
+      std::cout << "thread " << i << " returns " << results[i]
+                << " after publishing " << rings[i].clauses
+                << " and reading " << readers[i].clauses << " clauses"
+                << std::endl;
+      assert (results[i] == 20);
+    }
+  }
+#endif
+  return 0;
+}
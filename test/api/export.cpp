@@ -0,0 +1,67 @@
+#include "../../src/cadical.hpp"
+
+#include <iostream>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+extern "C" {
+#include <assert.h>
+}
+
+class Exporter : CaDiCaL::ClauseExporter {
+  CaDiCaL::Solver * solver;
+public:
+  unsigned clauses, batches;
+  int64_t max_id;
+  Exporter (CaDiCaL::Solver * s, int batch) :
+    solver (s), clauses (0), batches (0), max_id (0)
+  {
+    solver->connect_clause_exporter (this, batch);
+  }
+  ~Exporter () { solver->disconnect_clause_exporter (); }
+  void export_clause (int64_t id, int glue, const int * lits, int size) {
+    assert (size > 0);
+    assert (glue > 0);
+    assert (id > max_id);
+    max_id = id;
+    std::cout << "solver[" << ((void*) solver) << "] exported clause "
+              << id << " with glue " << glue << " of size " << size << ':';
+    for (int i = 0; i < size; i++)
+      std::cout << ' ' << lits[i];
+    std::cout << std::endl << std::flush;
+    clauses++;
+  }
+  void export_clauses (const int * records, size_t size, int n) {
+    batches++;
+    CaDiCaL::ClauseExporter::export_clauses (records, size, n);
+  }
+};
+
+static void formula (CaDiCaL::Solver & solver) {
+  for (int r = -1; r < 2; r += 2)
+    for (int s = -1; s < 2; s += 2)
+      for (int t = -1; t < 2; t += 2)
+	solver.add (r * 1), solver.add (s * 2), solver.add (t * 3),
+	solver.add (0);
+}
+
+int main () {
+  CaDiCaL::Solver ping, pong;
+  Exporter wing (&ping, 0), wong (&pong, 2);
+  formula (ping), formula (pong);
+  int a = ping.solve ();
+  std::cout << "ping returns " << a << std::endl;
+  std::cout << "wing exported " << wing.clauses << " clauses" << std::endl;
+  int b = pong.solve ();
+  std::cout << "pong returns " << b << std::endl;
+  std::cout << "wong exported " << wong.clauses << " clauses in "
+            << wong.batches << " batches" << std::endl;
+  assert (a == b), assert (a == 20);
+  assert (wing.clauses == wong.clauses);
+  assert (wing.clauses > 0);
+  assert (!wing.batches);
+  assert (wong.batches == (wong.clauses + 1) / 2);
+  return 0;
+}
@@ -0,0 +1,219 @@
+#include "../../src/cadical.hpp"
+
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+extern "C" {
+#include <assert.h>
+}
+
+// Export learned clauses of one solver in batches of packed records and
+// hand the collected buffer over in one piece to another solver.
+
+class Buffer : public CaDiCaL::ClauseExporter,
+               public CaDiCaL::LearnSource {
+  std::vector<int> records, dummy;
+  bool pending;
+public:
+  int exported;
+  Buffer () : pending (false), exported (0) { }
+  void export_clause (int64_t, int, const int *, int) { assert (0); }
+  void export_clauses (const int * r, size_t size, int clauses) {
+    records.insert (records.end (), r, r + size);
+    exported += clauses;
+    pending = true;
+  }
+  void reset () { pending = !records.empty (); }
+  void duplicate () {
+    const size_t size = records.size ();
+    for (size_t i = 0; i < size; i++) records.push_back (records[i]);
+    reset ();
+  }
+  bool hasNextClause () { return pending; }
+  const std::vector<int> & getNextClause () { assert (0); return dummy; }
+  const int * getNextClauses (size_t & size) {
+    if (!pending) { size = 0; return 0; }
+    pending = false;
+    size = records.size ();
+    return records.data ();
+  }
+};
+
+static void formula (CaDiCaL::Solver & solver) {
+  for (int r = -1; r < 2; r += 2)
+    for (int s = -1; s < 2; s += 2)
+      for (int t = -1; t < 2; t += 2)
+	solver.add (r * 1), solver.add (s * 2), solver.add (t * 3),
+	solver.add (0);
+}
+
+// A learn source which hands out one clause in the 'delay'-th call of
+// 'hasNextClause'.  Since importing is checked once before every decision,
+// the clause is imported after the first 'delay - 1' assumptions have been
+// decided (if there is no conflict before).
+
+class Delayed : public CaDiCaL::LearnSource {
+  std::vector<int> record;
+  int calls, delay;
+  bool pending;
+public:
+  Delayed () : calls (0), delay (0), pending (false) { }
+  void send (int64_t id, const std::vector<int> & lits, int d) {
+    int halves[2];
+    memcpy (halves, &id, sizeof id);
+    record.clear ();
+    record.push_back (2);
+    record.push_back (halves[0]), record.push_back (halves[1]);
+    record.insert (record.end (), lits.begin (), lits.end ());
+    calls = 0, delay = d, pending = true;
+  }
+  bool hasNextClause () { return pending && ++calls >= delay; }
+  const std::vector<int> & getNextClause () {
+    assert (pending);
+    pending = false;
+    return record;
+  }
+};
+
+static std::string path (const char * name) {
+  const char * prefix = getenv ("CADICALBUILD");
+  std::string res = prefix ? prefix : ".";
+  res += "/test-api-import-";
+  res += name;
+  return res;
+}
+
+// The formula consists of all eight ternary clauses over '1', '2', '3',
+// the implications '4 -> 5' and '4 -> 6' and four clauses which under
+// '-1', '5' and '6' encode the parity of '8' and '9'.  The other instance
+// derives (in a hand written proof) the lemmas '1 -5 8', '1 -6 -8' and
+// from those '1 -5 -6', as well as '1 2', where only the last two are
+// sent.  They are imported while solving under assumptions.  Under '-1'
+// and '4' the first one is falsified with two literals on the highest
+// level (without propagation noticing the conflict) and thus analyzed as
+// conflict, while under '-1' the second one propagates '2', which leads to
+// the root-level unit '1'.  Finally the merged proof is checked.
+
+static const int clauses[][5] = {
+  {1,2,3,0}, {1,2,-3,0}, {1,-2,3,0}, {1,-2,-3,0},
+  {-1,2,3,0}, {-1,2,-3,0}, {-1,-2,3,0}, {-1,-2,-3,0},
+  {-4,5,0}, {-4,6,0},
+  {1,-5,8,9,0}, {1,-5,8,-9,0}, {1,-6,-8,9,0}, {1,-6,-8,-9,0}
+};
+
+static const int original = sizeof clauses / sizeof *clauses;
+
+static void levels () {
+  const std::string dimacs = path ("levels.cnf");
+  const std::string other = path ("levels1.lrat");
+  const std::string proof = path ("levels2.lrat");
+  const std::string merged = path ("levels.lrat");
+  FILE * file = fopen (dimacs.c_str (), "w");
+  assert (file);
+  fprintf (file, "p cnf 9 %d\n", original);
+  for (const auto & c : clauses) {
+    for (const int * p = c; *p; p++) fprintf (file, "%d ", *p);
+    fputs ("0\n", file);
+  }
+  fclose (file);
+  const int64_t first = original + 5, second = original + 7;
+  file = fopen (other.c_str (), "w");
+  assert (file);
+  fprintf (file, "%d 1 -5 8 0 11 12 0\n", original + 1);
+  fprintf (file, "%d 1 -6 -8 0 13 14 0\n", original + 3);
+  fprintf (file, "%" PRId64 " 1 -5 -6 0 %d %d 0\n",
+           first, original + 1, original + 3);
+  fprintf (file, "%" PRId64 " 1 2 0 1 2 0\n", second);
+  fclose (file);
+  {
+    CaDiCaL::Solver solver;
+    solver.set ("instance_num", 2), solver.set ("total_instances", 2);
+    solver.set ("num_original_clauses", original);
+    solver.set ("lrat", 1), solver.set ("binary", 0);
+    solver.trace_proof (proof.c_str ());
+    for (const auto & c : clauses)
+      for (const int * p = c; ; p++) {
+        solver.add (*p);
+        if (!*p) break;
+      }
+    Delayed source;
+    solver.connect_learn_source (&source);
+
+    source.send (first, { 1, -5, -6 }, 3);
+    solver.assume (-1), solver.assume (4);
+    int res = solver.solve ();
+    std::cout << "conflicting import returns " << res << std::endl;
+    assert (res == 20);
+    assert (solver.failed (4));
+    assert (solver.get_stats ().conflicts == 1);
+
+    source.send (second, { 1, 2 }, 2);
+    solver.assume (-1);
+    res = solver.solve ();
+    std::cout << "propagating import returns " << res << std::endl;
+    assert (res == 20);
+    assert (solver.failed (-1));
+    assert (solver.fixed (1) > 0);
+    assert (solver.get_stats ().conflicts == 2);
+
+    res = solver.solve ();
+    std::cout << "final call returns " << res << std::endl;
+    assert (res == 20);
+    solver.disconnect_learn_source ();
+    solver.close_proof_trace ();
+  }
+  const char * prefix = getenv ("CADICALBUILD");
+  const std::string build = prefix ? prefix : ".";
+  std::string cmd = build + "/lratmerge -q " + dimacs + " " + other + " " +
+                    proof + " -o " + merged;
+  std::cout << cmd << std::endl;
+  assert (!system (cmd.c_str ()));
+  cmd = build + "/lratcheck -q " + dimacs + " " + merged;
+  std::cout << cmd << std::endl;
+  assert (!system (cmd.c_str ()));
+}
+
+static int import (Buffer & buffer, CaDiCaL::Solver & solver) {
+  formula (solver);
+  solver.connect_learn_source (&buffer);
+  int res = solver.solve ();
+  solver.disconnect_learn_source ();
+  assert (!buffer.hasNextClause ());
+  return res;
+}
+
+int main () {
+  CaDiCaL::Solver ping, pong, pang, pung;
+  ping.set ("instance_num", 1), ping.set ("total_instances", 4);
+  pong.set ("instance_num", 2), pong.set ("total_instances", 4);
+  pang.set ("instance_num", 3), pang.set ("total_instances", 4);
+  pung.set ("instance_num", 4), pung.set ("total_instances", 4);
+  pang.set ("importlim", 1), pang.set ("importglue", 2);
+  Buffer buffer;
+  ping.connect_clause_exporter (&buffer, 3);
+  formula (ping);
+  int a = ping.solve ();
+  ping.disconnect_clause_exporter ();
+  std::cout << "ping returns " << a << " after exporting "
+            << buffer.exported << " clauses" << std::endl;
+  assert (buffer.exported > 0);
+  int b = import (buffer, pong);
+  std::cout << "pong returns " << b << std::endl;
+  buffer.reset ();
+  int c = import (buffer, pang);
+  std::cout << "pang returns " << c << std::endl;
+  buffer.duplicate ();
+  int d = import (buffer, pung);
+  std::cout << "pung returns " << d << " after receiving duplicates"
+            << std::endl;
+  assert (a == b), assert (a == c), assert (a == d), assert (a == 20);
+  levels ();
+  return 0;
+}
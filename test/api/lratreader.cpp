@@ -0,0 +1,219 @@
+#include "../../src/cadical.hpp"
+#include "../../src/clausering.hpp"
+#include "../../src/lratreader.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+extern "C" {
+#include <assert.h>
+}
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Read back LRAT and FRAT proofs traced in ASCII and binary format (and
+// written asynchronously).  Then merge and check delta encoded proofs of
+// two solvers sharing clauses.
+
+static string path (const char * name) {
+  const char * prefix = getenv ("CADICALBUILD");
+  string res = prefix ? prefix : ".";
+  res += "/test-api-lratreader-";
+  res += name;
+  return res;
+}
+
+static const int holes = 5, pigeons = holes + 1;
+
+static int pigeon_hole (Solver & solver, FILE * dimacs) {
+  int clauses = 0;
+  auto add = [&] (int lit) {
+    solver.add (lit);
+    if (dimacs) fprintf (dimacs, lit ? "%d " : "0\n", lit);
+    if (!lit) clauses++;
+  };
+  for (int p = 0; p < pigeons; p++) {
+    for (int h = 0; h < holes; h++)
+      add (p * holes + h + 1);
+    add (0);
+  }
+  for (int h = 0; h < holes; h++)
+    for (int p = 0; p < pigeons; p++)
+      for (int q = p + 1; q < pigeons; q++)
+	add (-(p * holes + h + 1)), add (-(q * holes + h + 1)), add (0);
+  return clauses;
+}
+
+struct Counts { int64_t original, added, deleted, sum; };
+
+static Counts check (const char * name, bool binary, bool frat,
+                     int64_t original, bool async = false,
+                     bool delta = false) {
+  const string proof = path (name);
+  {
+    Solver solver;
+    solver.set ("binary", binary);
+    solver.set ("frat", frat);
+    solver.set ("proofasync", async);
+    solver.set ("lratdelta", delta);
+    solver.set ("num_original_clauses", original);
+    solver.trace_proof (proof.c_str ());
+    pigeon_hole (solver, 0);
+    int res = solver.solve ();
+    assert (res == 20);
+    solver.close_proof_trace ();
+  }
+  LratReader reader;
+  bool ok = reader.open (proof.c_str (), binary, frat, delta);
+  assert (ok);
+  Counts counts = { 0, 0, 0, 0 };
+  LratStep step;
+  bool empty = false;
+  for (;;) {
+    LratStep::Type type = reader.next (step, true);
+    if (type == LratStep::ERROR) cerr << reader.error () << endl;
+    assert (type != LratStep::ERROR);
+    if (type == LratStep::END) break;
+    assert (!empty);
+    if (type == LratStep::ORIGINAL) {
+      assert (step.id <= original);
+      counts.original++;
+    } else if (type == LratStep::ADD) {
+      assert (step.id > original);
+      assert (!step.hints.empty ());
+      empty = step.lits.empty ();
+      counts.added++;
+      for (const auto & hint : step.hints) {
+        assert (0 < hint && hint < step.id);
+        counts.sum += hint;
+      }
+    } else {
+      assert (type == LratStep::DELETE);
+      assert (!step.hints.empty ());
+      counts.deleted += step.hints.size ();
+      for (const auto & id : step.hints) counts.sum += id;
+    }
+  }
+  assert (empty);
+  cout << name << ": " << counts.original << " original, " << counts.added
+       << " added, " << counts.deleted << " deleted" << endl;
+  return counts;
+}
+
+// The second solver imports the clauses of the first one, which has the
+// same formula but solves it before.  Thus many imported clauses have
+// larger identifiers than the lemmas of the second solver using them as
+// hints.  These forward hints have to be read back from delta encoded
+// proofs and the merged proof has to pass the checker.
+
+static void share (const string & dimacs_path, int64_t original) {
+  const string first = path ("share1.lrat"), second = path ("share2.lrat");
+  const string merged = path ("merged.lrat");
+  ClauseRing ring;
+  ClauseRingReader reader;
+  reader.connect (&ring);
+  Solver ping, pong;
+  int i = 0;
+  for (auto solver : { &ping, &pong }) {
+    solver->set ("instance_num", ++i);
+    solver->set ("total_instances", 2);
+    solver->set ("num_original_clauses", original);
+    solver->set ("binary", 1);
+    solver->set ("lrat", 1);
+    solver->set ("lratdelta", 1);
+    solver->set ("seed", i);
+    solver->trace_proof ((i == 1 ? first : second).c_str ());
+    pigeon_hole (*solver, 0);
+  }
+  ping.connect_clause_exporter (&ring, 2);
+  int res = ping.solve ();
+  assert (res == 20);
+  ping.disconnect_clause_exporter ();
+  ping.close_proof_trace ();
+  pong.connect_learn_source (&reader);
+  res = pong.solve ();
+  assert (res == 20);
+  pong.disconnect_learn_source ();
+  pong.close_proof_trace ();
+  cout << "share: " << ring.clauses << " shared, " << reader.clauses
+       << " imported" << endl;
+  assert (reader.clauses > 0);
+
+  int64_t forward = 0;
+  LratReader delta;
+  bool ok = delta.open (second.c_str (), true, false, true);
+  assert (ok);
+  LratStep step;
+  for (;;) {
+    LratStep::Type type = delta.next (step, false);
+    if (type == LratStep::ERROR) cerr << delta.error () << endl;
+    assert (type != LratStep::ERROR);
+    if (type == LratStep::END) break;
+    for (const auto & hint : step.hints)
+      if (hint > step.id) forward++;
+  }
+  cout << "share: " << forward << " forward hints" << endl;
+  assert (forward > 0);
+
+  const char * prefix = getenv ("CADICALBUILD");
+  const string build = prefix ? prefix : ".";
+  const string merge = build + "/lratmerge -q --delta --delta-output -o " +
+                       merged + " " + dimacs_path + " " + first + " " +
+                       second;
+  res = system (merge.c_str ());
+  assert (!res);
+  const string check = build + "/lratcheck -q --delta " + dimacs_path +
+                       " " + merged;
+  res = system (check.c_str ());
+  assert (!res);
+}
+
+int main () {
+  const string dimacs_path = path ("ph.cnf");
+  int64_t original;
+  {
+    Solver solver;
+    FILE * dimacs = fopen (dimacs_path.c_str (), "w");
+    assert (dimacs);
+    fprintf (dimacs, "c pigeon hole\np cnf %d %d\n", pigeons * holes,
+             pigeons + holes * pigeons * (pigeons - 1) / 2);
+    original = pigeon_hole (solver, dimacs);
+    fclose (dimacs);
+  }
+  assert (read_dimacs_clauses (dimacs_path.c_str ()) == original);
+
+  Counts lrat = check ("ascii.lrat", false, false, original);
+  Counts blrat = check ("binary.lrat", true, false, original);
+  Counts frat = check ("ascii.frat", false, true, original);
+  Counts bfrat = check ("binary.frat", true, true, original);
+  Counts alrat = check ("async.lrat", true, false, original, true);
+  Counts dlrat = check ("delta.lrat", true, false, original, false, true);
+
+  // Compressed in-process (if configured) or through 'gzip'.
+
+  char * gzip = File::find ("gzip");
+  if (gzip || File::decompressible ("ph.lrat.gz")) {
+    Counts zlrat = check ("binary.lrat.gz", true, false, original);
+    assert (zlrat.added == blrat.added && zlrat.deleted == blrat.deleted);
+  }
+  delete [] gzip;
+
+  assert (!lrat.original && !blrat.original);
+  assert (frat.original == original && bfrat.original == original);
+  assert (lrat.added == blrat.added && lrat.added == frat.added);
+  assert (frat.added == bfrat.added && blrat.added == alrat.added);
+  assert (lrat.deleted == blrat.deleted && frat.deleted == bfrat.deleted);
+  assert (blrat.deleted == alrat.deleted);
+  assert (blrat.added == dlrat.added && blrat.deleted == dlrat.deleted);
+  assert (lrat.sum == blrat.sum && blrat.sum == dlrat.sum);
+
+  share (dimacs_path, original);
+
+  return 0;
+}
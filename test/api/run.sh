@@ -47,9 +47,11 @@ makefile=$CADICALBUILD/makefile
 
 CXX=`grep '^CXX=' "$makefile"|sed -e 's,CXX=,,'`
 CXXFLAGS=`grep '^CXXFLAGS=' "$makefile"|sed -e 's,CXXFLAGS=,,'`
+LIBS=`grep '^LIBS=' "$makefile"|sed -e 's,LIBS=,,'`
 
 msg "using CXX=$CXX"
 msg "using CXXFLAGS=$CXXFLAGS"
+[ x"$LIBS" = x ] || msg "using LIBS=$LIBS"
 
 tests=../test/api
 
@@ -86,7 +88,7 @@ run () {
   rm -f $name.log $name.o $name
   status=0
   cmd $COMPILE$language -o $name.o -c $src
-  cmd $COMPILE -o $name $name.o -L$CADICALBUILD -lcadical
+  cmd $COMPILE -o $name $name.o -L$CADICALBUILD -lcadical $LIBS
   cmd $name
   if test $status = 0
   then
@@ -107,6 +109,10 @@ run ctest
 run example
 run terminate
 run learn
+run export
+run import
+run clausering
+run lratreader
 run cfreeze
 run traverse
 run cipasir
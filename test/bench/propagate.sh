@@ -0,0 +1,82 @@
+#!/bin/sh
+
+#--------------------------------------------------------------------------#
+
+# Compare the number of propagations per second on the benchmarks in this
+# directory for different option settings.  Each argument is one setting,
+# i.e., a space separated list of options, and the first setting is the
+# base line for the ratios.  For instance
+#
+#   bench/propagate.sh "" "--prefetch=4"
+#
+# compares the default with prefetching four watches ahead.  The conflict
+# limit per run can be set with the environment variable 'LIMIT'.
+
+die () {
+  cecho "${HIDE}test/bench/propagate.sh:${NORMAL} ${BAD}error:${NORMAL} $*"
+  exit 1
+}
+
+msg () {
+  cecho "${HIDE}test/bench/propagate.sh:${NORMAL} $*"
+}
+
+for dir in . .. ../..
+do
+  [ -f $dir/scripts/colors.sh ] || continue
+  . $dir/scripts/colors.sh || exit 1
+  break
+done
+
+#--------------------------------------------------------------------------#
+
+[ -d ../test -a -d ../test/bench ] || \
+die "needs to be called from a top-level sub-directory of CaDiCaL"
+
+[ x"$CADICALBUILD" = x ] && CADICALBUILD="../build"
+
+[ -x "$CADICALBUILD/cadical" ] || \
+  die "can not find '$CADICALBUILD/cadical' (run 'make' first)"
+
+[ $# -gt 0 ] || set -- ""
+
+limit=100000
+[ x"$LIMIT" = x ] || limit=$LIMIT
+
+cecho -n "$HILITE"
+cecho "---------------------------------------------------------"
+cecho "propagation benchmarking in '$CADICALBUILD' ($limit conflicts)"
+cecho "---------------------------------------------------------"
+cecho -n "$NORMAL"
+
+make -C $CADICALBUILD
+res=$?
+[ $res = 0 ] || exit $res
+
+#--------------------------------------------------------------------------#
+
+solver="$CADICALBUILD/cadical"
+
+speed () {
+  "$solver" -c $limit $* 2>/dev/null | \
+  awk '/^c propagations:/{print $4}'
+}
+
+for cnf in ../test/bench/*.cnf
+do
+  name=`basename $cnf .cnf`
+  base=""
+  for setting in "$@"
+  do
+    prps=`speed $cnf $setting`
+    if [ x"$prps" = x ]
+    then
+      msg "$name '$setting' ${BAD}FAILED${NORMAL}"
+      continue
+    fi
+    [ x"$base" = x ] && base=$prps
+    ratio=`echo "$base $prps"|awk '{printf "%.2f", $1 ? $2 / $1 : 0}'`
+    msg "$name '$setting'" \
+        "${HILITE}$prps${NORMAL} M propagations per second (ratio $ratio)"
+  done
+done
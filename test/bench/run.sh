@@ -0,0 +1,73 @@
+#!/bin/sh
+
+#--------------------------------------------------------------------------#
+
+# Compare the number of conflicts per second on the benchmarks in this
+# directory without proof and while tracing an LRAT proof.  The overhead of
+# building LRAT chains should be small, i.e., the ratio close to one.  The
+# conflict limit per run can be set with the first argument.
+
+die () {
+  cecho "${HIDE}test/bench/run.sh:${NORMAL} ${BAD}error:${NORMAL} $*"
+  exit 1
+}
+
+msg () {
+  cecho "${HIDE}test/bench/run.sh:${NORMAL} $*"
+}
+
+for dir in . .. ../..
+do
+  [ -f $dir/scripts/colors.sh ] || continue
+  . $dir/scripts/colors.sh || exit 1
+  break
+done
+
+#--------------------------------------------------------------------------#
+
+[ -d ../test -a -d ../test/bench ] || \
+die "needs to be called from a top-level sub-directory of CaDiCaL"
+
+[ x"$CADICALBUILD" = x ] && CADICALBUILD="../build"
+
+[ -x "$CADICALBUILD/cadical" ] || \
+  die "can not find '$CADICALBUILD/cadical' (run 'make' first)"
+
+limit=100000
+[ $# -gt 0 ] && limit=$1
+
+cecho -n "$HILITE"
+cecho "---------------------------------------------------------"
+cecho "LRAT benchmarking in '$CADICALBUILD' ($limit conflicts)"
+cecho "---------------------------------------------------------"
+cecho -n "$NORMAL"
+
+make -C $CADICALBUILD
+res=$?
+[ $res = 0 ] || exit $res
+
+#--------------------------------------------------------------------------#
+
+solver="$CADICALBUILD/cadical"
+
+speed () {
+  "$solver" -c $limit $* 2>/dev/null | \
+  awk '/^c conflicts:/{print $4}'
+}
+
+for cnf in ../test/bench/*.cnf
+do
+  name=`basename $cnf .cnf`
+  prf=$CADICALBUILD/test-bench-$name.lrat
+  plain=`speed $cnf`
+  lrat=`speed $cnf $prf --lrat=true --binary=true`
+  rm -f $prf
+  if [ x"$plain" = x -o x"$lrat" = x ]
+  then
+    msg "$name ${BAD}FAILED${NORMAL}"
+    continue
+  fi
+  ratio=`echo "$plain $lrat"|awk '{printf "%.2f", $1 ? $2 / $1 : 0}'`
+  msg "$name ${HILITE}$plain${NORMAL} plain" \
+      "${HILITE}$lrat${NORMAL} lrat conflicts per second (ratio $ratio)"
+done
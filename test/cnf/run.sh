@@ -44,7 +44,7 @@ coresolver="$CADICALBUILD/cadical"
 simpsolver="$CADICALBUILD/../scripts/run-simplifier-and-extend-solution.sh"
 proofchecker=$CADICALBUILD/drat-trim
 solutionchecker=$CADICALBUILD/precochk
-fratchecker=../../drat-trim/lrat-check
+fratchecker=$CADICALBUILD/lratcheck
 makefile=$CADICALBUILD/makefile
 
 if [ ! -f $proofchecker -o ! -f $solutionchecker ]
@@ -87,9 +87,15 @@ fi
 ok=0
 failed=0
 
+# All instances are solved again with the options in 'variantopts', where
+# 'variant' distinguishes the names of the files written by these runs.
+
+variant=""
+variantopts=""
+
 core () {
-  msg "running CNF test core ${HILITE}'$1'${NORMAL}"
-  prefix=$CADICALBUILD/test-cnf-core
+  msg "running CNF test core ${HILITE}'$1'${NORMAL}$variantopts"
+  prefix=$CADICALBUILD/test-cnf-core$variant
   cnf=../test/cnf/$1.cnf
   prf=$prefix-$1.prf
   log=$prefix-$1.log
@@ -109,15 +115,15 @@ core () {
     proofopts=" $prf --lrat=true --binary=false"
   fi
 
-  cnfsimp=../test/cnf/$1-simp.cnf
-  opts="$cnf $1 -c 0 -o $cnfsimp"
+  cnfsimp=../test/cnf/$1$variant-simp.cnf
+  opts="$cnf $1 -c 0 -o $cnfsimp$variantopts"
   cecho "MWW added code here."
   cecho "$coresolver \\"
   cecho "$opts"
   "$coresolver" $opts 1>$log 2>$err
   cecho "MWW preprocessed."
 
-  opts="$cnfsimp --check$solopts$proofopts"
+  opts="$cnfsimp --check$solopts$proofopts$variantopts"
   cecho "$coresolver \\"
   cecho "$opts"
   cecho -n "# $2 ..."
@@ -225,11 +231,40 @@ simp () {
   fi
 }
 
+# Compares exit code, output lines and proof of a variant with the first
+# run, which have to be identical if 'variant' is deterministic.
+
+identical () {
+  base=$CADICALBUILD/test-cnf-core-$1
+  this=$CADICALBUILD/test-cnf-core$variant-$1
+  grep '^[sv]' $this.log > $this.out
+  cecho -n "# identical to '$base' ..."
+  if [ ! $res = $2 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+    failed=`expr $failed + 1`
+  elif ! grep '^[sv]' $base.log | cmp -s - $this.out
+  then
+    cecho " ${BAD}FAILED${NORMAL} (different output)"
+    failed=`expr $failed + 1`
+  elif [ ! x"$proofopts" = x ] && ! cmp -s $base.prf $this.prf
+  then
+    cecho " ${BAD}FAILED${NORMAL} (different proof)"
+    failed=`expr $failed + 1`
+  else
+    cecho " ${GOOD}ok${NORMAL}"
+    ok=`expr $ok + 1`
+  fi
+}
+
 run () {
   core $*
   # simp $*
+  [ x"$deterministic" = xyes ] && identical $*
 }
 
+all () {
+
 run empty 10
 # run false 20
 
@@ -327,6 +362,29 @@ run add128 20
 
 run prime65537 20
 
+}
+
+all
+
+# Incremental garbage collection in many small steps (see 'collect.cpp').
+
+variant=-collectinc
+variantopts=" --collectinc=1 --collectincbytes=1000"
+all
+
+# Clauses allocated in the slab (see 'slab.hpp').
+
+variant=-slab
+variantopts=" --slab=1"
+all
+
+# Parallel elimination and collection give the same result as sequential.
+
+variant=-threads
+variantopts=" --elimthreads=4 --collectthreads=4"
+deterministic=yes
+all
+
 #--------------------------------------------------------------------------#
 
 [ $ok -gt 0 ] && OK="$GOOD"
@@ -118,6 +118,15 @@ do
   run 20 $option ../test/cnf/add16.cnf
 done
 
+if [ x"`$solver --build 2>/dev/null|grep NTHREADS`" = x ]
+then
+  for option in --threads=1 --threads=2 --threads=5
+  do
+    run 10 $option ../test/cnf/prime2209.cnf
+    run 20 $option ../test/cnf/add16.cnf
+  done
+fi
+
 # run 0 -t
 # run 0 -O
 # run 0 -c 0